@@ -0,0 +1,653 @@
+/*
+Baked Wave - October 2026
+
+"borderOfWaveAndParticle.c" has no input and fixed numbers (deltaRAngle, NUM_TARGETS), so every run is exactly the same.
+This simulates it once, saves every frame to a file, and then plays the file back without simulating anything.
+Playback only has to mmap the file and decode one frame per tick, so it starts straight away and runs on anything.
+
+Usage:
+    bakedWave bake [file] [ticks]       simulate up to ticks ticks (default BAKE_TICKS) and write file (default wave.bake),
+                                        then read it back and check every frame decodes to what was baked
+    bakedWave [file]                    play file back, looping
+
+Period detection:
+    The targets turn by rotationAngle, which itself goes up by deltaRAngle every tick, so the pattern speeds up and wraps around.
+    With 0.225 it would come back around every 3200 ticks (0.225 * n * (n - 1) / 2 degrees goes up by a multiple of 360 when n goes up by 3200),
+    but that is with exact maths. The targets are rotated a little bit at a time in floats, and by 3200 ticks the error has built up enough
+    that the real pattern doesn't line up with itself any more, so the stock numbers usually bake without a period.
+    So instead of trusting the maths we look for it: after WARMUP_TICKS (longer than any bullet lives, so the screen only depends on recent shots)
+    every period P is tried, and P counts if every frame from there on matches the frame P ticks earlier to within MATCH_TOLERANCE.
+    If one is found, only WARMUP_TICKS + P frames are saved and playback loops back to frame WARMUP_TICKS.
+    If not, everything is saved and playback loops the whole thing.
+
+File layout:
+    BakeHeader
+    uint32 frameOffsets[numFrames + 1]      so any frame can be found without reading the ones before it
+    frames
+
+Each frame is:
+    NUM_TARGETS target positions as int16
+    alive bitmask, one bit per bullet
+    x and y of every alive bullet as zigzag varints
+
+Positions are fixed point (1/POS_SCALE px). Bullets fly in straight lines at a constant speed, so how far a bullet moved this
+tick is the same as last tick, and we store the change in that ("delta of delta") which is nearly always 0 or +-1, one byte.
+Frame 0 and the loop frame are keyframes, stored against nothing, so playback can start or jump back there.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "raylib.h"
+
+void simInit(void);
+void simUpdate(void);
+void setTargets(void);
+void getVelocities(int bulIndex, int targIndex);
+void resetBullet(int index);
+
+int bake(const char *path, int ticks);
+int findPeriod(int numFrames);
+bool framesMatch(int a, int b, int period);
+bool checkBake(const char *path, int numFrames);
+int play(const char *path);
+bool openBake(const char *path);
+void closeBake(void);
+void resetDecoder(void);
+bool decodeFrame(int frame);
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define NUM_TARGETS 5
+#define MAX_BULLETS 1200
+#define MAX_VELOCITY 5
+
+#define BAKE_MAGIC "BWPB"
+#define BAKE_VERSION 1
+#define BAKE_TICKS 8000
+#define WARMUP_TICKS 300
+#define MATCH_TOLERANCE 16
+#define POS_SCALE 16.0f
+#define TARGET_SCALE 1024.0f
+#define MASK_BYTES ((MAX_BULLETS + 7) / 8)
+
+// Worst case for one frame: targets, the mask, and every bullet with two 5 byte varints
+#define MAX_FRAME_BYTES (NUM_TARGETS * 4 + MASK_BYTES + MAX_BULLETS * 10)
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+typedef struct BakeHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t maxBullets;
+    uint32_t numTargets;
+    uint32_t numFrames;
+    uint32_t loopFrame;
+    float posScale;
+    float targetScale;
+} BakeHeader;
+
+// One frame, quantized. Used for period detection while baking and as the output of decoding.
+typedef struct Frame {
+    int16_t targetX[NUM_TARGETS];
+    int16_t targetY[NUM_TARGETS];
+    uint8_t alive[MASK_BYTES];
+    int16_t x[MAX_BULLETS];
+    int16_t y[MAX_BULLETS];
+} Frame;
+
+// Simulation, same as borderOfWaveAndParticle.c
+Vector2 targets[NUM_TARGETS];
+Bullet bullets[MAX_BULLETS];
+int curBullet;
+float rotationAngle = 0;
+float deltaRAngle = 0.225f;
+
+// Baking
+Frame *bakedFrames;
+
+// Playback
+const uint8_t *bakeFile;
+size_t bakeFileSize;
+const BakeHeader *bakeHeader;
+const uint32_t *frameOffsets;
+Frame playFrame;
+
+// Decoder state for each bullet: last position and last step, for x and y
+int32_t lastX[MAX_BULLETS];
+int32_t lastY[MAX_BULLETS];
+int32_t stepX[MAX_BULLETS];
+int32_t stepY[MAX_BULLETS];
+uint8_t lastAlive[MASK_BYTES];
+
+int main(int argc, char **argv) {
+
+    if (argc >= 2 && strcmp(argv[1], "bake") == 0) {
+        const char *path = (argc >= 3) ? argv[2] : "wave.bake";
+        int ticks = (argc >= 4) ? atoi(argv[3]) : BAKE_TICKS;
+
+        return bake(path, ticks);
+    }
+
+    return play((argc >= 2) ? argv[1] : "wave.bake");
+}
+
+// Simulation ============================================================
+
+void simInit(void) {
+    setTargets();
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        resetBullet(i);
+    }
+
+    curBullet = 0;
+    rotationAngle = 0;
+}
+
+// update() from borderOfWaveAndParticle.c
+void simUpdate(void) {
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            bullets[i].position.x += bullets[i].velocity.x;
+            bullets[i].position.y += bullets[i].velocity.y;
+        }
+
+        if (bullets[i].position.x > SCREEN_WIDTH / 2 || bullets[i].position.x < -SCREEN_WIDTH / 2) {
+            resetBullet(i);
+        }
+        else if (bullets[i].position.y > SCREEN_HEIGHT / 2 || bullets[i].position.y < -SCREEN_HEIGHT / 2) {
+            resetBullet(i);
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+
+        bullets[curBullet].isActive = true;
+
+        getVelocities(curBullet, i);
+
+        bullets[curBullet].position = targets[i];
+
+        curBullet++;
+
+        if (curBullet >= MAX_BULLETS) {
+            curBullet = 0;
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float xComponent = (targets[i].x * cos(rotationAngle * DEG2RAD)) -
+                           (targets[i].y * sin(rotationAngle * DEG2RAD));
+        float yComponent = (targets[i].x * sin(rotationAngle * DEG2RAD)) +
+                           (targets[i].y * cos(rotationAngle * DEG2RAD));
+        targets[i] = (Vector2) {xComponent, yComponent};
+    }
+
+    rotationAngle += deltaRAngle;
+}
+
+// Just your classic "n circular points made from rotating [1; 0] with a rotation matrix"
+void setTargets(void) {
+    float deltaAngle = 360 / NUM_TARGETS;
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float angle = (deltaAngle * i) * DEG2RAD;
+
+        targets[i].x = cos(angle);
+        targets[i].y = sin(angle);
+    }
+}
+
+// Just your classic similar triangles problem
+void getVelocities(int bulIndex, int targIndex) {
+    float deltaX = targets[targIndex].x;
+    float deltaY = targets[targIndex].y;
+
+    float hyp = sqrt( pow(deltaX, 2) + pow(deltaY, 2));
+
+    bullets[bulIndex].velocity.x = MAX_VELOCITY * (deltaX / hyp);
+    bullets[bulIndex].velocity.y = MAX_VELOCITY * (deltaY / hyp);
+}
+
+void resetBullet(int index) {
+    bullets[index].position = (Vector2) {0, 0};
+    bullets[index].velocity = (Vector2) {0, 0};
+    bullets[index].isActive = false;
+}
+
+// Baking ================================================================
+
+static uint8_t *putVarint(uint8_t *out, int32_t value) {
+    uint32_t zigzag = ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+
+    while (zigzag >= 0x80) {
+        *out++ = (uint8_t) (zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    *out++ = (uint8_t) zigzag;
+
+    return out;
+}
+
+static const uint8_t *getVarint(const uint8_t *in, const uint8_t *end, int32_t *value) {
+    uint32_t zigzag = 0;
+    int shift = 0;
+
+    while (in < end && shift < 35) {
+        uint8_t byte = *in++;
+        zigzag |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+
+        if (!(byte & 0x80)) {
+            *value = (int32_t) (zigzag >> 1) ^ -(int32_t) (zigzag & 1);
+            return in;
+        }
+    }
+
+    return NULL;
+}
+
+static bool isAlive(const uint8_t *mask, int i) {
+    return (mask[i / 8] >> (i % 8)) & 1;
+}
+
+// x and y of one bullet against the decoder state. A bullet that wasn't alive last frame (or any bullet on a keyframe) starts from 0.
+static uint8_t *encodeAxis(uint8_t *out, int32_t value, int32_t *last, int32_t *step, bool continuing) {
+    if (!continuing) {
+        out = putVarint(out, value);
+        *step = 0;
+    }
+    else {
+        int32_t newStep = value - *last;
+        out = putVarint(out, newStep - *step);
+        *step = newStep;
+    }
+
+    *last = value;
+
+    return out;
+}
+
+int bake(const char *path, int ticks) {
+    if (ticks < 1) {
+        ticks = 1;
+    }
+
+    bakedFrames = malloc(sizeof(Frame) * ticks);
+    if (bakedFrames == NULL) {
+        fprintf(stderr, "not enough memory for %d ticks\n", ticks);
+        return 1;
+    }
+
+    simInit();
+
+    // The frame stored for tick t is what draw() would show after update() t + 1
+    for (int t = 0; t < ticks; t++) {
+        simUpdate();
+
+        Frame *frame = &bakedFrames[t];
+        memset(frame->alive, 0, MASK_BYTES);
+
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            frame->targetX[i] = (int16_t) lrintf(targets[i].x * TARGET_SCALE);
+            frame->targetY[i] = (int16_t) lrintf(targets[i].y * TARGET_SCALE);
+        }
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                frame->alive[i / 8] |= 1 << (i % 8);
+                frame->x[i] = (int16_t) lrintf(bullets[i].position.x * POS_SCALE);
+                frame->y[i] = (int16_t) lrintf(bullets[i].position.y * POS_SCALE);
+            }
+            else {
+                frame->x[i] = 0;
+                frame->y[i] = 0;
+            }
+        }
+    }
+
+    int period = findPeriod(ticks);
+    int numFrames = (period > 0) ? WARMUP_TICKS + period : ticks;
+    int loopFrame = (period > 0) ? WARMUP_TICKS : 0;
+
+    if (period > 0) {
+        printf("period: %d ticks, saving %d frames\n", period, numFrames);
+    }
+    else {
+        printf("no period in %d ticks, saving all of them\n", ticks);
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "could not write %s\n", path);
+        free(bakedFrames);
+        return 1;
+    }
+
+    BakeHeader header = {0};
+    memcpy(header.magic, BAKE_MAGIC, 4);
+    header.version = BAKE_VERSION;
+    header.maxBullets = MAX_BULLETS;
+    header.numTargets = NUM_TARGETS;
+    header.numFrames = numFrames;
+    header.loopFrame = loopFrame;
+    header.posScale = POS_SCALE;
+    header.targetScale = TARGET_SCALE;
+
+    uint32_t *offsets = malloc(sizeof(uint32_t) * (numFrames + 1));
+    uint8_t *buffer = malloc(MAX_FRAME_BYTES);
+
+    // Offsets aren't known until the frames are encoded, so leave a hole and fill it in at the end
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(offsets, sizeof(uint32_t), numFrames + 1, file);
+
+    uint32_t offset = sizeof(header) + sizeof(uint32_t) * (numFrames + 1);
+
+    for (int f = 0; f < numFrames; f++) {
+        Frame *frame = &bakedFrames[f];
+        bool keyframe = (f == 0 || f == loopFrame);
+        uint8_t *cur = buffer;
+
+        if (keyframe) {
+            memset(lastAlive, 0, MASK_BYTES);
+        }
+
+        memcpy(cur, frame->targetX, sizeof(frame->targetX));
+        cur += sizeof(frame->targetX);
+        memcpy(cur, frame->targetY, sizeof(frame->targetY));
+        cur += sizeof(frame->targetY);
+        memcpy(cur, frame->alive, MASK_BYTES);
+        cur += MASK_BYTES;
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (isAlive(frame->alive, i)) {
+                bool continuing = isAlive(lastAlive, i);
+                cur = encodeAxis(cur, frame->x[i], &lastX[i], &stepX[i], continuing);
+                cur = encodeAxis(cur, frame->y[i], &lastY[i], &stepY[i], continuing);
+            }
+        }
+
+        memcpy(lastAlive, frame->alive, MASK_BYTES);
+
+        offsets[f] = offset;
+        fwrite(buffer, 1, cur - buffer, file);
+        offset += cur - buffer;
+    }
+
+    offsets[numFrames] = offset;
+
+    fseek(file, sizeof(header), SEEK_SET);
+    fwrite(offsets, sizeof(uint32_t), numFrames + 1, file);
+    fclose(file);
+
+    printf("wrote %s: %.2f MB, %.0f bytes per frame\n", path, offset / (1024.0 * 1024.0), (double) offset / numFrames);
+
+    free(buffer);
+    free(offsets);
+
+    bool ok = checkBake(path, numFrames);
+
+    free(bakedFrames);
+
+    return ok ? 0 : 1;
+}
+
+// Reads the file back the way play() does and decodes every frame in order, it has to come out as exactly what was baked
+bool checkBake(const char *path, int numFrames) {
+    if (!openBake(path)) {
+        return false;
+    }
+
+    resetDecoder();
+
+    for (int f = 0; f < numFrames; f++) {
+        const Frame *baked = &bakedFrames[f];
+
+        if (!decodeFrame(f)) {
+            fprintf(stderr, "check: frame %d is corrupt\n", f);
+            closeBake();
+            return false;
+        }
+
+        bool same = memcmp(playFrame.targetX, baked->targetX, sizeof(baked->targetX)) == 0 &&
+                    memcmp(playFrame.targetY, baked->targetY, sizeof(baked->targetY)) == 0 &&
+                    memcmp(playFrame.alive, baked->alive, MASK_BYTES) == 0;
+
+        for (int i = 0; same && i < MAX_BULLETS; i++) {
+            if (isAlive(baked->alive, i) && (playFrame.x[i] != baked->x[i] || playFrame.y[i] != baked->y[i])) {
+                same = false;
+            }
+        }
+
+        if (!same) {
+            fprintf(stderr, "check: frame %d doesn't decode to what was baked\n", f);
+            closeBake();
+            return false;
+        }
+    }
+
+    closeBake();
+
+    printf("check: all %d frames decode back exactly\n", numFrames);
+
+    return true;
+}
+
+// Smallest P where every frame after the warm-up matches the one P before it, or 0
+// Needs at least WARMUP_TICKS of frames past the first repeat, so one lucky frame can't count as a period
+int findPeriod(int numFrames) {
+    for (int period = 1; WARMUP_TICKS + period + WARMUP_TICKS <= numFrames; period++) {
+        bool repeats = true;
+
+        for (int t = WARMUP_TICKS + period; t < numFrames; t++) {
+            if (!framesMatch(t, t - period, period)) {
+                repeats = false;
+                break;
+            }
+        }
+
+        if (repeats) {
+            return period;
+        }
+    }
+
+    return 0;
+}
+
+/*
+Frame b is period ticks before frame a. NUM_TARGETS bullets are shot a tick, so the bullet in slot i of frame a
+was shot into slot i - NUM_TARGETS * period in frame b. Comparing slot i to slot i would need the period to also be a
+multiple of MAX_BULLETS / NUM_TARGETS, which 3200 is not.
+*/
+bool framesMatch(int a, int b, int period) {
+    const Frame *fa = &bakedFrames[a];
+    const Frame *fb = &bakedFrames[b];
+    int shift = (int) (((long) NUM_TARGETS * period) % MAX_BULLETS);
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        int j = (i - shift + MAX_BULLETS) % MAX_BULLETS;
+
+        if (isAlive(fa->alive, i) != isAlive(fb->alive, j)) {
+            return false;
+        }
+
+        if (abs(fa->x[i] - fb->x[j]) > MATCH_TOLERANCE || abs(fa->y[i] - fb->y[j]) > MATCH_TOLERANCE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Playback ==============================================================
+
+int play(const char *path) {
+    if (!openBake(path)) {
+        return 1;
+    }
+
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    int frame = 0;
+    resetDecoder();
+
+    while (!WindowShouldClose())
+    {
+        double start = GetTime();
+
+        if (!decodeFrame(frame)) {
+            TraceLog(LOG_ERROR, "BAKE: frame %d is corrupt", frame);
+            break;
+        }
+
+        double decodeMs = (GetTime() - start) * 1000.0;
+
+        BeginDrawing();
+
+            ClearBackground(BLACK);
+
+            for (int i = 0; i < NUM_TARGETS; i++) {
+                DrawCircle(playFrame.targetX[i] / TARGET_SCALE + SCREEN_WIDTH / 2, playFrame.targetY[i] / TARGET_SCALE + SCREEN_HEIGHT / 2, 5, YELLOW);
+            }
+
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                if (isAlive(playFrame.alive, i)) {
+                    Vector2 tempPos = (Vector2) {playFrame.x[i] / POS_SCALE + SCREEN_WIDTH / 2, playFrame.y[i] / POS_SCALE + SCREEN_HEIGHT / 2};
+                    DrawCircleV(tempPos, 5, PURPLE);
+                }
+            }
+
+            DrawText(TextFormat("frame %d / %d (loops to %d), decode %.3f ms", frame, bakeHeader->numFrames, bakeHeader->loopFrame, decodeMs),
+                     10, 10, 20, DARKGRAY);
+
+        EndDrawing();
+
+        // The loop frame is a keyframe, so decodeFrame() can start over from there
+        frame++;
+        if (frame >= (int) bakeHeader->numFrames) {
+            frame = bakeHeader->loopFrame;
+        }
+    }
+
+    CloseWindow();
+
+    closeBake();
+
+    return 0;
+}
+
+bool openBake(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "could not open %s, run \"bakedWave bake %s\" first\n", path, path);
+        return false;
+    }
+
+    struct stat info;
+    fstat(fd, &info);
+    bakeFileSize = info.st_size;
+
+    bakeFile = (bakeFileSize >= sizeof(BakeHeader)) ? mmap(NULL, bakeFileSize, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (bakeFile == MAP_FAILED) {
+        fprintf(stderr, "could not map %s\n", path);
+        return false;
+    }
+
+    bakeHeader = (const BakeHeader *) bakeFile;
+    frameOffsets = (const uint32_t *) (bakeFile + sizeof(BakeHeader));
+
+    if (memcmp(bakeHeader->magic, BAKE_MAGIC, 4) != 0 || bakeHeader->version != BAKE_VERSION ||
+        bakeHeader->maxBullets != MAX_BULLETS || bakeHeader->numTargets != NUM_TARGETS || bakeHeader->numFrames == 0 ||
+        sizeof(BakeHeader) + sizeof(uint32_t) * (bakeHeader->numFrames + 1) > bakeFileSize ||
+        frameOffsets[bakeHeader->numFrames] > bakeFileSize) {
+        fprintf(stderr, "%s is not a bake from this version\n", path);
+        closeBake();
+        return false;
+    }
+
+    return true;
+}
+
+void closeBake(void) {
+    munmap((void *) bakeFile, bakeFileSize);
+}
+
+void resetDecoder(void) {
+    memset(lastAlive, 0, MASK_BYTES);
+}
+
+static const uint8_t *decodeAxis(const uint8_t *in, const uint8_t *end, int16_t *out, int32_t *last, int32_t *step, bool continuing) {
+    int32_t value;
+
+    in = getVarint(in, end, &value);
+    if (in == NULL) {
+        return NULL;
+    }
+
+    if (!continuing) {
+        *last = value;
+        *step = 0;
+    }
+    else {
+        *step += value;
+        *last += *step;
+    }
+
+    *out = (int16_t) *last;
+
+    return in;
+}
+
+// Frames have to be decoded in order after a keyframe, since each one is stored against the one before
+bool decodeFrame(int frame) {
+    // Same keyframes as bake(), their bullets are stored against nothing, whatever was decoded before them
+    if (frame == 0 || frame == (int) bakeHeader->loopFrame) {
+        resetDecoder();
+    }
+
+    const uint8_t *cur = bakeFile + frameOffsets[frame];
+    const uint8_t *end = bakeFile + frameOffsets[frame + 1];
+
+    if (end < cur || (size_t) (end - cur) < sizeof(playFrame.targetX) + sizeof(playFrame.targetY) + MASK_BYTES) {
+        return false;
+    }
+
+    memcpy(playFrame.targetX, cur, sizeof(playFrame.targetX));
+    cur += sizeof(playFrame.targetX);
+    memcpy(playFrame.targetY, cur, sizeof(playFrame.targetY));
+    cur += sizeof(playFrame.targetY);
+    memcpy(playFrame.alive, cur, MASK_BYTES);
+    cur += MASK_BYTES;
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (isAlive(playFrame.alive, i)) {
+            bool continuing = isAlive(lastAlive, i);
+
+            cur = decodeAxis(cur, end, &playFrame.x[i], &lastX[i], &stepX[i], continuing);
+            if (cur == NULL) { return false; }
+
+            cur = decodeAxis(cur, end, &playFrame.y[i], &lastY[i], &stepY[i], continuing);
+            if (cur == NULL) { return false; }
+        }
+    }
+
+    memcpy(lastAlive, playFrame.alive, MASK_BYTES);
+
+    return true;
+}
@@ -0,0 +1,380 @@
+/*
+    Bezier editor - lots of single control point beziers you can pick and drag
+
+    bezier_2pts.c sets targetPts[] straight from the mouse, which is fine for 3 points
+    but for picking with tens of thousands of points, checking every point under the mouse every frame gets slow
+
+    so all the points live in a grid (bucket every point by which GRID_CELL x GRID_CELL square it is in)
+        - nearest point: look in the mouse's cell, then the ring of cells around it, then the next ring, ...
+            stop once the next ring is further away than the best point found so far
+        - rectangle select: only look in the cells the rectangle covers
+        - dragging: a point only changes buckets when it crosses a cell border, and that is just unlinking and relinking it,
+            so the grid never has to be rebuilt
+
+    each cell is a doubly linked list threaded through the cellNext / cellPrev arrays, so taking a point out is O(1)
+
+    Controls:
+        left click on a point       drag it (drags the whole selection if the point is selected)
+        left drag on empty space    rectangle select
+        right click                 clear selection
+        L                           switch to plain linear scans, to compare the timings
+*/
+
+#include <math.h>
+#include <stdbool.h>
+
+#include "raylib.h"
+
+#define NUM_CURVES 10000
+#define NUM_POINTS (NUM_CURVES * 3)
+#define GRID_CELL 16
+#define PICK_RADIUS 8
+
+void initialize(void);
+void update(void);
+void draw(void);
+
+int cellOf(Vector2 position);
+void gridInsert(int point);
+void gridRemove(int point);
+void movePoint(int point, Vector2 position);
+void clearSelection(void);
+int nearestPoint(Vector2 position, float maxDistance);
+int selectRect(Rectangle rect);
+
+const int screenWidth = 1280;
+const int screenHeight = 720;
+
+#define GRID_WIDTH ((1280 + GRID_CELL - 1) / GRID_CELL)
+#define GRID_HEIGHT ((720 + GRID_CELL - 1) / GRID_CELL)
+
+typedef enum State {
+    IDLE,
+    DRAGGING,
+    SELECTING
+} State;
+
+// Curve i uses points 3i (start), 3i + 1 (control) and 3i + 2 (end), same order as targetPts in bezier_2pts.c
+Vector2 points[NUM_POINTS];
+
+// The selection is kept as a list as well, so clearing or dragging it only touches the selected points
+bool selected[NUM_POINTS];
+int selection[NUM_POINTS];
+int numSelected = 0;
+
+// The grid. -1 is the end of a list.
+int cellHead[GRID_WIDTH * GRID_HEIGHT];
+int cellNext[NUM_POINTS];
+int cellPrev[NUM_POINTS];
+int pointCell[NUM_POINTS];
+
+State editState = IDLE;
+bool linearScan = false;
+
+int hoverPt = -1;
+int dragPt = -1;
+Vector2 selectStart;
+Rectangle selectBox;
+
+// Stats for the HUD
+double pickMicros = 0;
+double selectMicros = 0;
+int pointsTested = 0;
+
+int main(void)
+{
+    initialize();
+
+    while (!WindowShouldClose())
+    {
+        update();
+
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void initialize(void) {
+    InitWindow(screenWidth, screenHeight, "raylib");
+    SetTargetFPS(60);
+
+    for (int c = 0; c < GRID_WIDTH * GRID_HEIGHT; c++) {
+        cellHead[c] = -1;
+    }
+
+    // Short random curves all over the screen
+    for (int i = 0; i < NUM_CURVES; i++) {
+        Vector2 start = (Vector2) {GetRandomValue(0, screenWidth - 1), GetRandomValue(0, screenHeight - 1)};
+
+        for (int j = 0; j < 3; j++) {
+            int p = (i * 3) + j;
+
+            points[p].x = start.x + GetRandomValue(-40, 40);
+            points[p].y = start.y + GetRandomValue(-40, 40);
+            selected[p] = false;
+
+            gridInsert(p);
+        }
+    }
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_L)) {
+        linearScan = !linearScan;
+    }
+
+    Vector2 mouse = GetMousePosition();
+
+    double start = GetTime();
+    hoverPt = nearestPoint(mouse, PICK_RADIUS);
+    pickMicros = (GetTime() - start) * 1000000.0;
+
+    switch (editState) {
+        case IDLE:
+
+            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+                if (hoverPt >= 0) {
+                    editState = DRAGGING;
+                    dragPt = hoverPt;
+                }
+                else {
+                    editState = SELECTING;
+                    selectStart = mouse;
+                    selectBox = (Rectangle) {mouse.x, mouse.y, 0, 0};
+                }
+            }
+            else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
+                clearSelection();
+            }
+
+            break;
+
+        case DRAGGING: {
+
+            Vector2 delta = GetMouseDelta();
+
+            if (delta.x != 0 || delta.y != 0) {
+                // Grabbing a selected point moves the whole selection with it
+                if (selected[dragPt]) {
+                    for (int s = 0; s < numSelected; s++) {
+                        int p = selection[s];
+                        movePoint(p, (Vector2) {points[p].x + delta.x, points[p].y + delta.y});
+                    }
+                }
+                else {
+                    movePoint(dragPt, (Vector2) {points[dragPt].x + delta.x, points[dragPt].y + delta.y});
+                }
+            }
+
+            if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+                editState = IDLE;
+                dragPt = -1;
+            }
+
+            break;
+        }
+
+        case SELECTING:
+
+            selectBox.x = fminf(selectStart.x, mouse.x);
+            selectBox.y = fminf(selectStart.y, mouse.y);
+            selectBox.width = fabsf(mouse.x - selectStart.x);
+            selectBox.height = fabsf(mouse.y - selectStart.y);
+
+            if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+                start = GetTime();
+                numSelected = selectRect(selectBox);
+                selectMicros = (GetTime() - start) * 1000000.0;
+
+                editState = IDLE;
+            }
+    }
+
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(RAYWHITE);
+
+        for (int i = 0; i < NUM_CURVES; i++) {
+            DrawLineBezierQuad(points[i * 3], points[(i * 3) + 2], points[(i * 3) + 1], 1, LIGHTGRAY);
+        }
+
+        for (int s = 0; s < numSelected; s++) {
+            DrawCircleV(points[selection[s]], 3, ORANGE);
+        }
+
+        if (hoverPt >= 0) {
+            DrawCircleV(points[hoverPt], 6, (hoverPt % 3 == 1) ? BLUE : ((hoverPt % 3 == 0) ? GREEN : RED));
+        }
+
+        if (editState == SELECTING) {
+            DrawRectangleLinesEx(selectBox, 1, DARKGRAY);
+        }
+
+        DrawRectangle(0, 0, 360, 110, Fade(RAYWHITE, 0.85f));
+        DrawText(TextFormat("%d points, %s [L]", NUM_POINTS, linearScan ? "linear scan" : "grid"), 10, 10, 20, BLACK);
+        DrawText(TextFormat("pick: %.1f us, %d points tested", pickMicros, pointsTested), 10, 35, 20, BLACK);
+        DrawText(TextFormat("select: %.1f us, %d selected", selectMicros, numSelected), 10, 60, 20, BLACK);
+        DrawFPS(10, 85);
+
+    EndDrawing();
+}
+
+// Points off the screen go in the nearest edge cell, so every point is always in the grid
+int cellOf(Vector2 position) {
+    int cx = (int) floorf(position.x / GRID_CELL);
+    int cy = (int) floorf(position.y / GRID_CELL);
+
+    if (cx < 0) { cx = 0; }
+    if (cx >= GRID_WIDTH) { cx = GRID_WIDTH - 1; }
+    if (cy < 0) { cy = 0; }
+    if (cy >= GRID_HEIGHT) { cy = GRID_HEIGHT - 1; }
+
+    return (cy * GRID_WIDTH) + cx;
+}
+
+void gridInsert(int point) {
+    int cell = cellOf(points[point]);
+
+    pointCell[point] = cell;
+    cellPrev[point] = -1;
+    cellNext[point] = cellHead[cell];
+
+    if (cellHead[cell] >= 0) {
+        cellPrev[cellHead[cell]] = point;
+    }
+    cellHead[cell] = point;
+}
+
+void gridRemove(int point) {
+    if (cellPrev[point] >= 0) {
+        cellNext[cellPrev[point]] = cellNext[point];
+    }
+    else {
+        cellHead[pointCell[point]] = cellNext[point];
+    }
+
+    if (cellNext[point] >= 0) {
+        cellPrev[cellNext[point]] = cellPrev[point];
+    }
+}
+
+// Most moves stay inside the same cell, and then the grid doesn't need touching at all
+void movePoint(int point, Vector2 position) {
+    points[point] = position;
+
+    if (cellOf(position) != pointCell[point]) {
+        gridRemove(point);
+        gridInsert(point);
+    }
+}
+
+// Returns -1 if nothing is within maxDistance
+int nearestPoint(Vector2 position, float maxDistance) {
+    int best = -1;
+    float bestDist = maxDistance * maxDistance;
+
+    pointsTested = 0;
+
+    if (linearScan) {
+        for (int p = 0; p < NUM_POINTS; p++) {
+            float dx = points[p].x - position.x;
+            float dy = points[p].y - position.y;
+            pointsTested++;
+
+            if ((dx * dx) + (dy * dy) <= bestDist) {
+                best = p;
+                bestDist = (dx * dx) + (dy * dy);
+            }
+        }
+
+        return best;
+    }
+
+    int home = cellOf(position);
+    int homeX = home % GRID_WIDTH;
+    int homeY = home / GRID_WIDTH;
+
+    // Ring r is the square of cells r away from the home cell. Everything in it is at least (r - 1) cells away.
+    for (int r = 0; r < GRID_WIDTH || r < GRID_HEIGHT; r++) {
+        float ringDist = (r - 1) * GRID_CELL;
+        if (r > 0 && ringDist * ringDist > bestDist) {
+            break;
+        }
+
+        for (int cy = homeY - r; cy <= homeY + r; cy++) {
+            if (cy < 0 || cy >= GRID_HEIGHT) { continue; }
+
+            for (int cx = homeX - r; cx <= homeX + r; cx++) {
+                if (cx < 0 || cx >= GRID_WIDTH) { continue; }
+
+                // Only the outline of the square, the inside was done on earlier rings
+                if (cy != homeY - r && cy != homeY + r && cx != homeX - r) {
+                    cx = homeX + r;
+                    if (cx >= GRID_WIDTH) { break; }
+                }
+
+                for (int p = cellHead[(cy * GRID_WIDTH) + cx]; p >= 0; p = cellNext[p]) {
+                    float dx = points[p].x - position.x;
+                    float dy = points[p].y - position.y;
+                    pointsTested++;
+
+                    if ((dx * dx) + (dy * dy) <= bestDist) {
+                        best = p;
+                        bestDist = (dx * dx) + (dy * dy);
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+void clearSelection(void) {
+    for (int s = 0; s < numSelected; s++) {
+        selected[selection[s]] = false;
+    }
+
+    numSelected = 0;
+}
+
+// Replaces the selection with every point inside rect, and returns how many there are
+int selectRect(Rectangle rect) {
+    clearSelection();
+
+    if (linearScan) {
+        for (int p = 0; p < NUM_POINTS; p++) {
+            if (CheckCollisionPointRec(points[p], rect)) {
+                selected[p] = true;
+                selection[numSelected] = p;
+                numSelected++;
+            }
+        }
+
+        return numSelected;
+    }
+
+    int first = cellOf((Vector2) {rect.x, rect.y});
+    int last = cellOf((Vector2) {rect.x + rect.width, rect.y + rect.height});
+
+    for (int cy = first / GRID_WIDTH; cy <= last / GRID_WIDTH; cy++) {
+        for (int cx = first % GRID_WIDTH; cx <= last % GRID_WIDTH; cx++) {
+            for (int p = cellHead[(cy * GRID_WIDTH) + cx]; p >= 0; p = cellNext[p]) {
+                if (CheckCollisionPointRec(points[p], rect)) {
+                    selected[p] = true;
+                    selection[numSelected] = p;
+                    numSelected++;
+                }
+            }
+        }
+    }
+
+    return numSelected;
+}
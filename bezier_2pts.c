@@ -8,6 +8,10 @@
             - done, just draw to a texture so that it gets preserved then draw out the texture to get your curve
         3. sometimes the moving point goes past the end point - how to make sure that it stops at the end point?
 			something you could do is that when the moving point is within some small distance from endPt (less than deltaX/Y), force it to endPt, then stop motion
+        4. only redraw when something changed - done
+            update() sets changed whenever it does something you would see. if nothing changed, the last frame is still on screen,
+            so we skip BeginDrawing/EndDrawing and sleep until there is input (EnableEventWaiting + PollInputEvents) instead of spinning at 60 fps
+            while placing points or looking at the result, that is almost all the time
 */
 
 #include <math.h>
@@ -22,6 +26,7 @@
 void initialize(void);
 void update(void);
 void draw(void);
+void waitForInput(void);
 
 const int screenWidth = 800;
 const int screenHeight = 450;
@@ -52,6 +57,15 @@ RenderTexture2D target;
 
 State gameState = PLACING_SE;
 
+// Set by update() when the screen needs redrawing, starts true so the first frame gets drawn
+bool changed = true;
+
+// Idle stats - frames where nothing changed and we slept instead of drawing
+long drawnFrames = 0;
+long idleFrames = 0;
+double idleTime = 0;
+double startTime = 0;
+
 int main(void) 
 {
     initialize();
@@ -60,9 +74,18 @@ int main(void)
     {
         update();
 
-        draw();
+        if (changed) {
+            draw();
+            changed = false;
+        }
+        else {
+            waitForInput();
+        }
     }
 
+    TraceLog(LOG_INFO, "IDLE: %ld frames drawn, %ld skipped, %.1f of %.1f s asleep",
+             drawnFrames, idleFrames, idleTime, GetTime() - startTime);
+
     CloseWindow();
 
     return 0;
@@ -84,6 +107,8 @@ void initialize(void) {
     BeginTextureMode(target);
     ClearBackground(RAYWHITE);
     EndTextureMode();
+
+    startTime = GetTime();
 }
 
 void update(void) {
@@ -97,14 +122,17 @@ void update(void) {
 
             if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                 targetPts[START_PT] = GetMousePosition();
+                changed = true;
             }
             else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
                 targetPts[END_PT] = GetMousePosition();
                 movingControlPts[1].target = targetPts[END_PT];
+                changed = true;
             }
 
             if (IsKeyPressed(KEY_TAB)) {
                 gameState = PLACING_C;
+                changed = true;
             }
 
             break;
@@ -116,13 +144,16 @@ void update(void) {
             if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                 targetPts[1] = GetMousePosition();
                 movingControlPts[0].target = targetPts[1];
+                changed = true;
             }
 
             if (IsKeyPressed(KEY_TAB)) {
                 gameState = PLACING_SE;
+                changed = true;
             }
             else if (IsKeyPressed(KEY_ENTER)) {
                 gameState = MOVING;
+                changed = true;
 
                 for (int i = 0; i < 2; i++) {
                     movingControlPts[i].delta.x = movingControlPts[i].target.x - movingControlPts[i].position.x;
@@ -141,6 +172,7 @@ void update(void) {
                 if (abs(movingControlPts[i].target.x - movingControlPts[i].position.x) > 0) {
                     movingControlPts[i].position.x += movingControlPts[i].delta.x / MOVE_STEPS;
                     movingControlPts[i].position.y += movingControlPts[i].delta.y / MOVE_STEPS;
+                    changed = true;
                 }
                 else {
                     if (i == 1) {
@@ -150,6 +182,8 @@ void update(void) {
             }
 
             if (ctrlMoving) {
+                changed = true;
+
                 // Not sure why it works when you divide the deltas by 60, or MOVE_STEPS / 2
                 float deltaX = (movingControlPts[1].position.x - movingControlPts[0].position.x) / 60;
                 float deltaY = (movingControlPts[1].position.y - movingControlPts[0].position.y) / 60;
@@ -170,9 +204,11 @@ void update(void) {
 
             if (IsKeyPressed(KEY_BACKSPACE) || IsKeyPressed(KEY_TAB)) {
                 gameState = PLACING_SE;
+                changed = true;
             }
             else if (IsKeyPressed(KEY_R)) {
                 gameState = RESULT;
+                changed = true;
             }
 
             break;
@@ -180,6 +216,7 @@ void update(void) {
         case RESULT:
             if (IsKeyPressed(KEY_TAB)) {
                 gameState = PLACING_SE;
+                changed = true;
 
                 BeginTextureMode(target);
 
@@ -237,5 +274,24 @@ void draw(void) {
             DrawTextureRec(target.texture, (Rectangle){0, 0, target.texture.width, -target.texture.height }, (Vector2) {0, 0}, WHITE);
         }
 
+        // Only updated when we draw anyway, otherwise the stats themselves would count as a change
+        double totalTime = GetTime() - startTime;
+        DrawText(TextFormat("idle %.0f%%, %ld frames skipped, %.1f s asleep",
+                            (totalTime > 0) ? 100.0 * idleTime / totalTime : 0, idleFrames, idleTime), 0, screenHeight - 20, 20, GRAY);
+
     EndDrawing();
+
+    drawnFrames++;
+}
+
+// Nothing changed, so the last frame is still on screen. Sleep until there is some input, then let update() look at it.
+void waitForInput(void) {
+    double start = GetTime();
+
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+
+    idleTime += GetTime() - start;
+    idleFrames++;
 }
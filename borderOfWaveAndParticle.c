@@ -3,6 +3,22 @@ Border of Wave and Particle - November 8-9, 2022
 
 An updated version of "projectilePattern.c"
 Now can have multiple target points and rotation is based on linear algebra.
+
+LOD mode (L to toggle, UP / DOWN to change LOD_THRESHOLD) - October 2026
+Most of the DrawCircleV calls end up on pixels that other bullets have already covered, so in LOD mode the screen is cut into
+LOD_CELL sized cells and we count the bullets in each one first. Cells with more than lodThreshold bullets aren't drawn bullet by bullet,
+they become one pixel of a small density texture that gets stretched over the whole screen, and the rest still get drawn normally.
+That way the worst case is a few hundred sprites per cell plus one texture, no matter how many bullets there are.
+
+Trail mode (T to cycle off / buffer / history) - October 2026
+Buffer: same idea as the canvas in bezier_2pts.c, a RenderTexture that never gets cleared. Every frame one full screen
+rectangle of Fade(BLACK, TRAIL_FADE) goes over it, which fades everything already there a bit, then only the bullets
+where they are now get drawn on top. So a trail costs nothing per bullet, it is whatever is left of the earlier frames,
+and the work is one screen of pixels + one sprite per bullet no matter how long the trails look.
+(The fade is a blend, so it stops at about 0.5 / TRAIL_FADE out of 255 instead of reaching black, too dark to see.)
+History: the usual way, for comparison. Every bullet keeps its last TRAIL_LENGTH positions and they all get drawn,
+older ones more see-through, so TRAIL_LENGTH sprites per bullet.
+The HUD shows the draw time of the one you're on and the memory both of them need.
 */
 
 #include <math.h>
@@ -15,6 +31,9 @@ void draw(void);
 void setTargets(void);
 void getVelocities(int bulIndex, int targIndex);
 void resetBullet(int index);
+void drawBulletsLod(void);
+void drawBulletsTrail(void);
+void clearTrails(void);
 
 #define SCREEN_WIDTH 1600
 #define SCREEN_HEIGHT 900
@@ -22,6 +41,14 @@ void resetBullet(int index);
 #define MAX_BULLETS 1200
 #define MAX_VELOCITY 5
 
+#define LOD_CELL 16
+#define LOD_WIDTH ((SCREEN_WIDTH + LOD_CELL - 1) / LOD_CELL)
+#define LOD_HEIGHT ((SCREEN_HEIGHT + LOD_CELL - 1) / LOD_CELL)
+#define LOD_THRESHOLD 6
+
+#define TRAIL_LENGTH 32
+#define TRAIL_FADE 0.15f
+
 typedef struct {
     Vector2 position;
     Vector2 velocity;
@@ -38,6 +65,35 @@ int curBullet;
 float rotationAngle = 0;
 float deltaRAngle = 0.225f;
 
+bool lodMode = false;
+int lodThreshold = LOD_THRESHOLD;
+
+// Bullets per cell this frame, and the density texture the dense cells get drawn into
+int lodCounts[LOD_WIDTH * LOD_HEIGHT];
+Color lodPixels[LOD_WIDTH * LOD_HEIGHT];
+Texture2D lodTexture;
+
+// What the LOD pass decided this frame
+int lodDenseCells;
+int lodSprites;
+int lodSplatted;
+double lodBinMs;
+double lodDrawMs;
+
+enum { TRAIL_OFF, TRAIL_BUFFER, TRAIL_HISTORY, NUM_TRAIL_MODES };
+const char *trailModeNames[NUM_TRAIL_MODES] = {"off", "buffer", "history"};
+int trailMode = TRAIL_OFF;
+
+// Buffer mode
+RenderTexture2D trailTarget;
+
+// History mode, trailHead is the newest slot for every bullet. Slots with x below -SCREEN_WIDTH are empty
+Vector2 trailHistory[MAX_BULLETS][TRAIL_LENGTH];
+int trailHead = 0;
+
+double trailDrawMs;
+int trailSprites;
+
 int main() {
 
     init();
@@ -63,10 +119,30 @@ void init(void) {
     for (int i = 0; i < MAX_BULLETS; i++) {
         resetBullet(i);
     }
+
+    Image lodImage = GenImageColor(LOD_WIDTH, LOD_HEIGHT, BLANK);
+    lodTexture = LoadTextureFromImage(lodImage);
+    UnloadImage(lodImage);
+
+    // Bilinear, so the stretched cells fade into each other instead of showing up as big squares
+    SetTextureFilter(lodTexture, TEXTURE_FILTER_BILINEAR);
+
+    trailTarget = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    clearTrails();
 }
 
 void update(void) {
 
+    if (IsKeyPressed(KEY_L)) { lodMode = !lodMode; }
+    if (IsKeyPressed(KEY_UP)) { lodThreshold++; }
+    if (IsKeyPressed(KEY_DOWN)) { lodThreshold--; }
+    if (lodThreshold < 1) { lodThreshold = 1; }
+
+    if (IsKeyPressed(KEY_T)) {
+        trailMode = (trailMode + 1) % NUM_TRAIL_MODES;
+        clearTrails();
+    }
+
     // Update bullets ====================================================
     for (int i = 0; i < MAX_BULLETS; i++) {
         // Updating position, if the bullet is active
@@ -114,6 +190,15 @@ void update(void) {
     }
 
     rotationAngle += deltaRAngle;
+
+    // Only history mode needs this, the buffer keeps its trails in the pixels
+    if (trailMode == TRAIL_HISTORY) {
+        trailHead = (trailHead + 1) % TRAIL_LENGTH;
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            trailHistory[i][trailHead] = bullets[i].isActive ? bullets[i].position : (Vector2) {-2 * SCREEN_WIDTH, 0};
+        }
+    }
 }
 
 void draw(void) {
@@ -130,16 +215,148 @@ void draw(void) {
             DrawCircle(targets[i].x + SCREEN_WIDTH / 2, targets[i].y + SCREEN_HEIGHT / 2, 5, YELLOW);
         }
 
-        for (int i = 0; i < MAX_BULLETS; i++) {
-            if (bullets[i].isActive) {
-                Vector2 tempPos = (Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2};
-                DrawCircleV(tempPos, 5, PURPLE);
+        if (trailMode != TRAIL_OFF) {
+            drawBulletsTrail();
+
+            DrawText(TextFormat("trails: %s, %d sprites, %.3f ms", trailModeNames[trailMode], trailSprites, trailDrawMs), 10, 10, 20, WHITE);
+            DrawText(TextFormat("memory: buffer %d KB, history %d KB", (SCREEN_WIDTH * SCREEN_HEIGHT * 4) / 1024,
+                     (int) (sizeof(trailHistory) / 1024)), 10, 35, 20, WHITE);
+        }
+        else if (lodMode) {
+            drawBulletsLod();
+
+            DrawText(TextFormat("LOD: threshold %d, %d dense cells", lodThreshold, lodDenseCells), 10, 10, 20, WHITE);
+            DrawText(TextFormat("%d sprites, %d splatted", lodSprites, lodSplatted), 10, 35, 20, WHITE);
+            DrawText(TextFormat("bin %.3f ms, draw %.3f ms", lodBinMs, lodDrawMs), 10, 60, 20, WHITE);
+        }
+        else {
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                if (bullets[i].isActive) {
+                    Vector2 tempPos = (Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2};
+                    DrawCircleV(tempPos, 5, PURPLE);
+                }
             }
         }
 
     EndDrawing();
 }
 
+void drawBulletsLod(void) {
+    double start = GetTime();
+
+    for (int c = 0; c < LOD_WIDTH * LOD_HEIGHT; c++) {
+        lodCounts[c] = 0;
+    }
+
+    // Screen space, same shift as the normal draw
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            int cx = (int) (bullets[i].position.x + SCREEN_WIDTH / 2) / LOD_CELL;
+            int cy = (int) (bullets[i].position.y + SCREEN_HEIGHT / 2) / LOD_CELL;
+
+            if (cx >= 0 && cx < LOD_WIDTH && cy >= 0 && cy < LOD_HEIGHT) {
+                lodCounts[(cy * LOD_WIDTH) + cx]++;
+            }
+        }
+    }
+
+    // Dense cells get a shade of purple that gets more solid the more bullets are in them, sparse ones are left see-through
+    lodDenseCells = 0;
+    lodSplatted = 0;
+
+    for (int c = 0; c < LOD_WIDTH * LOD_HEIGHT; c++) {
+        if (lodCounts[c] > lodThreshold) {
+            float fill = 0.5f + 0.5f * fminf(1.0f, (float) lodCounts[c] / (4 * lodThreshold));
+            lodPixels[c] = ColorAlpha(PURPLE, fill);
+
+            lodDenseCells++;
+            lodSplatted += lodCounts[c];
+        }
+        else {
+            lodPixels[c] = BLANK;
+        }
+    }
+
+    lodBinMs = (GetTime() - start) * 1000.0;
+    start = GetTime();
+
+    UpdateTexture(lodTexture, lodPixels);
+    DrawTexturePro(lodTexture, (Rectangle) {0, 0, LOD_WIDTH, LOD_HEIGHT},
+                   (Rectangle) {0, 0, LOD_WIDTH * LOD_CELL, LOD_HEIGHT * LOD_CELL}, (Vector2) {0, 0}, 0, WHITE);
+
+    lodSprites = 0;
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            Vector2 tempPos = (Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2};
+            int cx = (int) tempPos.x / LOD_CELL;
+            int cy = (int) tempPos.y / LOD_CELL;
+
+            // Off the grid counts as sparse, it is just a sliver at the edge
+            if (cx < 0 || cx >= LOD_WIDTH || cy < 0 || cy >= LOD_HEIGHT || lodCounts[(cy * LOD_WIDTH) + cx] <= lodThreshold) {
+                DrawCircleV(tempPos, 5, PURPLE);
+                lodSprites++;
+            }
+        }
+    }
+
+    lodDrawMs = (GetTime() - start) * 1000.0;
+}
+
+void drawBulletsTrail(void) {
+    double start = GetTime();
+
+    trailSprites = 0;
+
+    if (trailMode == TRAIL_BUFFER) {
+        BeginTextureMode(trailTarget);
+
+            // The fade, one rectangle over everything that's already there
+            DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, TRAIL_FADE));
+
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                if (bullets[i].isActive) {
+                    DrawCircleV((Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2}, 5, PURPLE);
+                    trailSprites++;
+                }
+            }
+
+        EndTextureMode();
+
+        // Render textures are upside down, same as bezier_2pts.c
+        DrawTextureRec(trailTarget.texture, (Rectangle) {0, 0, trailTarget.texture.width, -trailTarget.texture.height}, (Vector2) {0, 0}, WHITE);
+    }
+    else {
+        // Oldest first so the newest end up on top, each one as faded as the buffer would have it by now
+        for (int age = TRAIL_LENGTH - 1; age >= 0; age--) {
+            int slot = (trailHead - age + TRAIL_LENGTH) % TRAIL_LENGTH;
+            Color color = Fade(PURPLE, powf(1 - TRAIL_FADE, age));
+
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                if (trailHistory[i][slot].x >= -SCREEN_WIDTH) {
+                    DrawCircleV((Vector2) {trailHistory[i][slot].x + SCREEN_WIDTH / 2, trailHistory[i][slot].y + SCREEN_HEIGHT / 2}, 5, color);
+                    trailSprites++;
+                }
+            }
+        }
+    }
+
+    trailDrawMs = (GetTime() - start) * 1000.0;
+}
+
+// Both kinds start over empty, so switching doesn't show trails from the last time you were in that mode
+void clearTrails(void) {
+    BeginTextureMode(trailTarget);
+        ClearBackground(BLACK);
+    EndTextureMode();
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        for (int j = 0; j < TRAIL_LENGTH; j++) {
+            trailHistory[i][j] = (Vector2) {-2 * SCREEN_WIDTH, 0};
+        }
+    }
+}
+
 // Just your classic "n circular points made from rotating [1; 0] with a rotation matrix"
 void setTargets(void) {
     float deltaAngle = 360 / NUM_TARGETS;
@@ -0,0 +1,503 @@
+/*
+Bullet Annihilation - October 2026
+
+An updated version of "borderOfWaveAndParticle.c"
+Two emitters fire counter-rotating rings at each other. Press C to turn on annihilation, where
+bullets from opposing emitters cancel each other out when they touch.
+
+Controls:
+    C           toggle annihilation
+    UP / DOWN   more / fewer rings per tick (pushes the bullet count up to MAX_BULLETS)
+
+Testing every bullet against every other bullet is n^2 / 2 tests, which is already 700k a frame at 1200 bullets.
+Instead we use sort-and-sweep on the x axis:
+    1. keep a list of the live bullets sorted by x
+    2. walk the list, and only test a bullet against the ones after it whose x is within one bullet diameter
+
+Bullets only move MAX_VELOCITY pixels per tick, so last tick's order is almost right and an insertion sort
+only has to do a handful of swaps. Newly fired bullets are sorted on their own and merged in.
+If a lot changes at once (turning the mode on, a huge volley) the insertion sort would go quadratic,
+so it gives up after SWAP_BUDGET swaps per bullet and we radix sort the whole list instead.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+void setTargets(void);
+void shoot(int emitter, int ring);
+void resetBullet(int index);
+
+void compactSweepList(void);
+void sortSweepList(void);
+bool insertionSort(int *idx, float *keys, int count, long maxSwaps);
+void radixSort(int *idx, float *keys, int count);
+void mergeNewBullets(void);
+void sweep(void);
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define NUM_EMITTERS 2
+#define NUM_TARGETS 5
+#define MAX_RINGS 32
+#define MAX_BULLETS 50000
+#define MAX_VELOCITY 5
+#define BULLET_RADIUS 3
+
+// Insertion sort gives up after this many swaps per listed bullet
+#define SWAP_BUDGET 16
+
+// Radix sort instead if more than 1 / RADIX_FRACTION of the list is new this tick
+#define RADIX_FRACTION 4
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    int emitter;
+    bool isActive;
+} Bullet;
+
+typedef struct {
+    Vector2 position;
+    Vector2 targets[NUM_TARGETS];
+    float deltaRAngle;
+    Color color;
+} Emitter;
+
+typedef enum SortMode {
+    SORT_NONE,
+    SORT_INSERTION,
+    SORT_RADIX
+} SortMode;
+
+// Per-tick stats for the HUD
+typedef struct SweepStats {
+    SortMode sortMode;
+    long swaps;
+    long tests;
+    int pairs;
+    double sortMs;
+    double sweepMs;
+} SweepStats;
+
+Emitter emitters[NUM_EMITTERS];
+Bullet bullets[MAX_BULLETS];
+
+// See borderOfWaveAndParticle.c
+int curBullet;
+int numRings = 1;
+
+bool annihilation = false;
+bool rebuildList = true;
+
+// The sweep list: bullet indices sorted by x, with the x values kept alongside so the sort doesn't
+// have to jump around the bullets array
+int sweepIdx[MAX_BULLETS];
+float sweepKeys[MAX_BULLETS];
+int sweepCount = 0;
+
+// Bullets fired this tick into a free slot, waiting to be merged into the sweep list
+int newIdx[MAX_BULLETS];
+float newKeys[MAX_BULLETS];
+int newCount = 0;
+
+// Scratch space for the radix sort and the merge
+int tempIdx[MAX_BULLETS];
+float tempKeys[MAX_BULLETS];
+
+SweepStats stats;
+int totalPairs = 0;
+
+int main() {
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    emitters[0].position = (Vector2) {-SCREEN_WIDTH / 4, 0};
+    emitters[0].deltaRAngle = 0.225f;
+    emitters[0].color = PURPLE;
+
+    emitters[1].position = (Vector2) {SCREEN_WIDTH / 4, 0};
+    emitters[1].deltaRAngle = -0.225f;
+    emitters[1].color = SKYBLUE;
+
+    setTargets();
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        resetBullet(i);
+    }
+
+    curBullet = 0;
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_C)) {
+        annihilation = !annihilation;
+
+        // The list goes stale while the mode is off, so build it from scratch when it comes back on
+        rebuildList = true;
+    }
+
+    if (IsKeyPressed(KEY_UP)) { numRings++; }
+    if (IsKeyPressed(KEY_DOWN)) { numRings--; }
+    if (numRings < 1) { numRings = 1; }
+    if (numRings > MAX_RINGS) { numRings = MAX_RINGS; }
+
+    // Update bullets ====================================================
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            bullets[i].position.x += bullets[i].velocity.x;
+            bullets[i].position.y += bullets[i].velocity.y;
+
+            if (bullets[i].position.x > SCREEN_WIDTH / 2 || bullets[i].position.x < -SCREEN_WIDTH / 2 ||
+                bullets[i].position.y > SCREEN_HEIGHT / 2 || bullets[i].position.y < -SCREEN_HEIGHT / 2) {
+                resetBullet(i);
+            }
+        }
+    }
+
+    // Dead bullets leave the list before we shoot, so every free slot we shoot into is guaranteed to be unlisted
+    if (annihilation && !rebuildList) {
+        compactSweepList();
+    }
+
+    // Shoot ===============================================================
+    newCount = 0;
+
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        for (int r = 0; r < numRings; r++) {
+            shoot(e, r);
+        }
+    }
+
+    // Annihilate ==========================================================
+    stats = (SweepStats) {0};
+
+    if (annihilation) {
+        sortSweepList();
+        sweep();
+    }
+
+    // Update targets ====================================================
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        float c = cos(emitters[e].deltaRAngle * DEG2RAD);
+        float s = sin(emitters[e].deltaRAngle * DEG2RAD);
+
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            Vector2 t = emitters[e].targets[i];
+            emitters[e].targets[i] = (Vector2) {(t.x * c) - (t.y * s), (t.x * s) + (t.y * c)};
+        }
+    }
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                Vector2 tempPos = (Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2};
+                DrawCircleV(tempPos, BULLET_RADIUS, emitters[bullets[i].emitter].color);
+            }
+        }
+
+        for (int e = 0; e < NUM_EMITTERS; e++) {
+            DrawCircle(emitters[e].position.x + SCREEN_WIDTH / 2, emitters[e].position.y + SCREEN_HEIGHT / 2, 5, YELLOW);
+        }
+
+        int live = 0;
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) { live++; }
+        }
+
+        const char *modeNames[] = {"-", "insertion", "radix"};
+
+        DrawRectangle(0, 0, 330, 190, Fade(BLACK, 0.7f));
+        DrawFPS(10, 10);
+        DrawText(TextFormat("bullets: %d  rings: %d", live, numRings), 10, 35, 20, WHITE);
+        DrawText(TextFormat("annihilation [C]: %s", annihilation ? "on" : "off"), 10, 60, 20, WHITE);
+
+        if (annihilation) {
+            DrawText(TextFormat("sort: %s, %ld swaps", modeNames[stats.sortMode], stats.swaps), 10, 85, 20, WHITE);
+            DrawText(TextFormat("tests: %ld (all pairs %.0f)", stats.tests, (double) live * (live - 1) / 2), 10, 110, 20, WHITE);
+            DrawText(TextFormat("pairs: %d now, %d total", stats.pairs, totalPairs), 10, 135, 20, WHITE);
+            DrawText(TextFormat("sort %.3f ms  sweep %.3f ms", stats.sortMs, stats.sweepMs), 10, 160, 20, WHITE);
+        }
+
+    EndDrawing();
+}
+
+// Same targets as borderOfWaveAndParticle.c, just one set per emitter
+void setTargets(void) {
+    float deltaAngle = 360 / NUM_TARGETS;
+
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            float angle = (deltaAngle * i) * DEG2RAD;
+
+            emitters[e].targets[i].x = cos(angle);
+            emitters[e].targets[i].y = sin(angle);
+        }
+    }
+}
+
+// Fire one ring from an emitter. Extra rings are spread evenly between the targets.
+void shoot(int emitter, int ring) {
+    float offset = (360.0f / NUM_TARGETS) * ring / numRings * DEG2RAD;
+    float c = cos(offset);
+    float s = sin(offset);
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        Vector2 t = emitters[emitter].targets[i];
+        Vector2 dir = (Vector2) {(t.x * c) - (t.y * s), (t.x * s) + (t.y * c)};
+
+        // A bullet still in flight is already in the sweep list, so only fresh slots need merging
+        if (annihilation && !rebuildList && !bullets[curBullet].isActive) {
+            newIdx[newCount] = curBullet;
+            newCount++;
+        }
+
+        bullets[curBullet].isActive = true;
+        bullets[curBullet].emitter = emitter;
+        bullets[curBullet].velocity = (Vector2) {MAX_VELOCITY * dir.x, MAX_VELOCITY * dir.y};
+        bullets[curBullet].position = (Vector2) {emitters[emitter].position.x + dir.x, emitters[emitter].position.y + dir.y};
+
+        curBullet++;
+        if (curBullet >= MAX_BULLETS) {
+            curBullet = 0;
+        }
+    }
+}
+
+void resetBullet(int index) {
+    bullets[index].position = (Vector2) {0, 0};
+    bullets[index].velocity = (Vector2) {0, 0};
+    bullets[index].isActive = false;
+}
+
+// Drop dead bullets from the sweep list, keeping the order of the rest
+void compactSweepList(void) {
+    int count = 0;
+
+    for (int k = 0; k < sweepCount; k++) {
+        if (bullets[sweepIdx[k]].isActive) {
+            sweepIdx[count] = sweepIdx[k];
+            count++;
+        }
+    }
+
+    sweepCount = count;
+}
+
+void sortSweepList(void) {
+    double start = GetTime();
+
+    if (rebuildList) {
+        sweepCount = 0;
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                sweepIdx[sweepCount] = i;
+                sweepCount++;
+            }
+        }
+    }
+
+    for (int k = 0; k < sweepCount; k++) {
+        sweepKeys[k] = bullets[sweepIdx[k]].position.x;
+    }
+    for (int k = 0; k < newCount; k++) {
+        newKeys[k] = bullets[newIdx[k]].position.x;
+    }
+
+    bool bigChange = rebuildList || newCount * RADIX_FRACTION > sweepCount;
+
+    if (!bigChange) {
+        stats.sortMode = SORT_INSERTION;
+
+        // The new bullets all start around the emitters, so they are close to sorted too
+        bool sorted = insertionSort(sweepIdx, sweepKeys, sweepCount, (long) sweepCount * SWAP_BUDGET) &&
+                      insertionSort(newIdx, newKeys, newCount, (long) newCount * newCount);
+
+        if (sorted) {
+            mergeNewBullets();
+        }
+        else {
+            bigChange = true;
+        }
+    }
+
+    if (bigChange) {
+        stats.sortMode = SORT_RADIX;
+
+        memcpy(sweepIdx + sweepCount, newIdx, newCount * sizeof(int));
+        memcpy(sweepKeys + sweepCount, newKeys, newCount * sizeof(float));
+        sweepCount += newCount;
+
+        radixSort(sweepIdx, sweepKeys, sweepCount);
+    }
+
+    newCount = 0;
+    rebuildList = false;
+
+    stats.sortMs = (GetTime() - start) * 1000.0;
+}
+
+// Returns false if it ran out of swaps. The list is left half sorted, but nothing is lost.
+bool insertionSort(int *idx, float *keys, int count, long maxSwaps) {
+    long swaps = 0;
+
+    for (int k = 1; k < count; k++) {
+        float key = keys[k];
+        int index = idx[k];
+        int j = k - 1;
+
+        while (j >= 0 && keys[j] > key) {
+            keys[j + 1] = keys[j];
+            idx[j + 1] = idx[j];
+            j--;
+            swaps++;
+        }
+
+        keys[j + 1] = key;
+        idx[j + 1] = index;
+
+        if (swaps > maxSwaps) {
+            stats.swaps += swaps;
+            return false;
+        }
+    }
+
+    stats.swaps += swaps;
+    return true;
+}
+
+/*
+LSD radix sort, 8 bits at a time.
+Floats don't sort as integers straight away: flip the sign bit for positives, and every bit for negatives,
+then the unsigned integer order matches the float order.
+*/
+void radixSort(int *idx, float *keys, int count) {
+    static uint32_t bits[MAX_BULLETS];
+    static uint32_t tempBits[MAX_BULLETS];
+
+    for (int k = 0; k < count; k++) {
+        uint32_t u;
+        memcpy(&u, &keys[k], sizeof(u));
+        bits[k] = (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+    }
+
+    uint32_t *srcBits = bits, *dstBits = tempBits;
+    int *srcIdx = idx, *dstIdx = tempIdx;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        int counts[256] = {0};
+
+        for (int k = 0; k < count; k++) {
+            counts[(srcBits[k] >> shift) & 0xFF]++;
+        }
+
+        int total = 0;
+        for (int b = 0; b < 256; b++) {
+            int c = counts[b];
+            counts[b] = total;
+            total += c;
+        }
+
+        for (int k = 0; k < count; k++) {
+            int dst = counts[(srcBits[k] >> shift) & 0xFF]++;
+            dstBits[dst] = srcBits[k];
+            dstIdx[dst] = srcIdx[k];
+        }
+
+        uint32_t *swapBits = srcBits; srcBits = dstBits; dstBits = swapBits;
+        int *swapIdx = srcIdx; srcIdx = dstIdx; dstIdx = swapIdx;
+    }
+
+    // 4 passes is an even number, so the sorted indices are already back in idx
+    for (int k = 0; k < count; k++) {
+        keys[k] = bullets[idx[k]].position.x;
+    }
+}
+
+// Both lists are sorted, so this is just the merge step from merge sort
+void mergeNewBullets(void) {
+    int a = 0, b = 0, out = 0;
+
+    while (a < sweepCount || b < newCount) {
+        if (b >= newCount || (a < sweepCount && sweepKeys[a] <= newKeys[b])) {
+            tempIdx[out] = sweepIdx[a];
+            tempKeys[out] = sweepKeys[a];
+            a++;
+        }
+        else {
+            tempIdx[out] = newIdx[b];
+            tempKeys[out] = newKeys[b];
+            b++;
+        }
+        out++;
+    }
+
+    sweepCount = out;
+    memcpy(sweepIdx, tempIdx, sweepCount * sizeof(int));
+    memcpy(sweepKeys, tempKeys, sweepCount * sizeof(float));
+}
+
+// Every bullet is the same size, so anything more than one diameter further along x can't be touching
+void sweep(void) {
+    double start = GetTime();
+    const float diameter = 2 * BULLET_RADIUS;
+
+    for (int a = 0; a < sweepCount; a++) {
+        Bullet *first = &bullets[sweepIdx[a]];
+
+        if (!first->isActive) {
+            continue;
+        }
+
+        for (int b = a + 1; b < sweepCount && sweepKeys[b] - sweepKeys[a] <= diameter; b++) {
+            Bullet *second = &bullets[sweepIdx[b]];
+            stats.tests++;
+
+            if (!second->isActive || first->emitter == second->emitter) {
+                continue;
+            }
+
+            float dx = second->position.x - first->position.x;
+            float dy = second->position.y - first->position.y;
+
+            if ((dx * dx) + (dy * dy) <= diameter * diameter) {
+                // Both go, and the dead ones fall out of the list when it is compacted next tick
+                resetBullet(sweepIdx[a]);
+                resetBullet(sweepIdx[b]);
+                stats.pairs++;
+                break;
+            }
+        }
+    }
+
+    totalPairs += stats.pairs;
+
+    stats.sweepMs = (GetTime() - start) * 1000.0;
+}
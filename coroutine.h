@@ -0,0 +1,65 @@
+/*
+    Stackless coroutines - October 2026
+
+    Lets a script that runs over many ticks be written top to bottom, instead of as a switch (gameState) spread over update() and draw()
+        eg.
+            CO_BEGIN(&s->co);
+                fire a ring
+                CO_WAIT(&s->co, tick, 10);
+                rotate
+            CO_END(&s->co);
+
+    How it works: the script is one big switch on the line number it stopped at (the same trick as Duff's device / protothreads)
+        CO_WAIT saves __LINE__ and returns, and next time the switch jumps straight back to the case label on that line
+    so a coroutine is just a Coroutine struct, there is no stack to save and nothing to allocate when it yields
+
+    Rules that come from that:
+        - local variables are gone after a yield, anything that needs to survive goes in your script's struct
+        - no switch statements of your own around a yield (your case labels would clash with ours)
+        - only one yield per line (the line number is the resume point)
+
+    A script function returns CO_RUNNING until it reaches CO_END, then CO_DONE.
+    The scheduler doesn't need to call a script before wakeTick, so sleeping scripts cost one compare a tick.
+*/
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+typedef struct Coroutine {
+    int line;
+    int wakeTick;
+} Coroutine;
+
+typedef enum CoStatus {
+    CO_RUNNING,
+    CO_DONE
+} CoStatus;
+
+#define CO_INIT(co) do { (co)->line = 0; (co)->wakeTick = 0; } while (0)
+
+#define CO_BEGIN(co) switch ((co)->line) { case 0:
+
+// Give up the rest of this tick, carry on next tick
+#define CO_YIELD(co) do { (co)->line = __LINE__; return CO_RUNNING; case __LINE__:; } while (0)
+
+// Sleep for ticks ticks (CO_WAIT(co, tick, 1) is the same as CO_YIELD)
+#define CO_WAIT(co, tick, ticks) do { (co)->wakeTick = (tick) + (ticks); (co)->line = __LINE__; return CO_RUNNING; case __LINE__:; } while (0)
+
+// CO_WAIT_UNTIL runs straight into its own case label on purpose (cond gets checked the same tick), this tells
+// -Wimplicit-fallthrough that. Compilers without the attribute don't have the warning either
+#if defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define CO_FALLTHROUGH __attribute__((fallthrough))
+#endif
+#endif
+
+#ifndef CO_FALLTHROUGH
+#define CO_FALLTHROUGH ((void) 0)
+#endif
+
+// Check cond once a tick, carry on the first tick it is true
+#define CO_WAIT_UNTIL(co, cond) do { (co)->line = __LINE__; CO_FALLTHROUGH; case __LINE__: if (!(cond)) { return CO_RUNNING; } } while (0)
+
+#define CO_END(co) } (co)->line = -1; return CO_DONE
+
+#endif
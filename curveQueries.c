@@ -0,0 +1,705 @@
+/*
+    Curve queries - bullets bouncing off a few hundred bezier walls
+
+    bezier_2pts.c can trace a curve but can't tell you anything about it, here every tick we ask
+        - for every bullet: did the step it just took cross a curve (then it bounces off)
+        - for every bullet: is it within GRAZE_RADIUS of a curve (then it is drawn red)
+        - for the mouse: the nearest point on any curve
+    that is a couple of thousand queries a tick against NUM_CURVES curves, so it needs to be more than "sample every curve 64 times"
+
+    how one query works
+        1. broad phase: every curve is bucketed in a BROAD_CELL grid by the bounding box of its control points
+            (a bezier never leaves the hull of its control points, so that box holds the whole curve)
+            a query only looks at the curves in the cells its own box covers
+        2. subdivision: split the curve in half (de Casteljau) again and again, throwing away every half whose hull box
+            can't beat the best answer so far (too far away, or the segment's line doesn't pass between its control points)
+            stop splitting once a piece is almost straight
+        3. Newton: the straight piece gives a good guess for t, a few Newton steps on the real curve fix it up
+
+    Controls:
+        R       new random curves
+        B       narrow phase: subdivision + Newton / plain sampling (BRUTE_SAMPLES points per curve), to compare the timings
+        G       broad phase on / off (off = every query tests every curve)
+*/
+
+#include <math.h>
+#include <stdbool.h>
+
+#include "raylib.h"
+#include "raymath.h"
+
+#define NUM_CURVES 400
+#define NUM_BULLETS 4000
+#define GRAZE_RADIUS 12
+#define MOUSE_RADIUS 200
+#define BROAD_CELL 64
+
+// Subdivision stops once the control point is this close to the middle of the chord, or after MAX_DEPTH splits
+#define FLAT_EPSILON 1.0f
+#define MAX_DEPTH 8
+#define NEWTON_STEPS 3
+// Newton only counts as a hit if it ends within HIT_EPSILON px of the segment's line, otherwise the piece is split again,
+// down to REFINE_DEPTH
+#define HIT_EPSILON 0.01f
+#define REFINE_DEPTH (MAX_DEPTH + 8)
+#define BRUTE_SAMPLES 64
+
+// fminf / fmaxf end up as calls into libm (they have to handle NaN), these are plain compares
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+void initialize(void);
+void update(void);
+void draw(void);
+
+void randomCurves(void);
+void buildBroadPhase(void);
+int gatherCurves(float minX, float minY, float maxX, float maxY);
+bool nearestOnCurve(int curve, Vector2 p, float *bestDistSq, float *bestT);
+bool segmentHitsCurve(int curve, Vector2 a, Vector2 b, float *bestU, float *bestT);
+bool nearestSampled(int curve, Vector2 p, float *bestDistSq, float *bestT);
+bool segmentHitsSampled(int curve, Vector2 a, Vector2 b, float *bestU, float *bestT);
+
+const int screenWidth = 1280;
+const int screenHeight = 720;
+
+#define GRID_WIDTH ((1280 + BROAD_CELL - 1) / BROAD_CELL)
+#define GRID_HEIGHT ((720 + BROAD_CELL - 1) / BROAD_CELL)
+#define MAX_CELL_ENTRIES (NUM_CURVES * 32)
+
+// Curve i is curves[i][0] (start), curves[i][1] (control), curves[i][2] (end), same order as targetPts in bezier_2pts.c
+Vector2 curves[NUM_CURVES][3];
+Rectangle curveBox[NUM_CURVES];
+
+// Broad phase, the curves in cell c are cellCurves[cellStart[c]] to cellCurves[cellStart[c + 1] - 1]
+int cellStart[GRID_WIDTH * GRID_HEIGHT + 1];
+int cellCurves[MAX_CELL_ENTRIES];
+
+// A curve can be in more than one cell, curveStamp stops a query from testing it twice
+int curveStamp[NUM_CURVES];
+int stamp = 0;
+int candidates[NUM_CURVES];
+
+// One half of a subdivided curve, t0 - t1 is the part of the original curve it covers
+typedef struct Piece {
+    Vector2 c[3];
+    float t0;
+    float t1;
+    int depth;
+} Piece;
+
+float hullDistSq(const Vector2 *c, Vector2 p);
+bool isFlat(const Piece *piece);
+void splitPiece(const Piece *piece, Piece *left, Piece *right);
+float sideOf(Vector2 p, Vector2 a, Vector2 d);
+
+typedef struct Bullet {
+    Vector2 position;
+    Vector2 velocity;
+    bool grazing;
+} Bullet;
+
+Bullet bullets[NUM_BULLETS];
+
+Vector2 mouseNearest;
+bool mouseFound = false;
+
+bool bruteForce = false;
+bool useBroadPhase = true;
+
+// Stats for the last tick
+double queryMs = 0;
+int candidatesTested = 0;
+int piecesVisited = 0;
+int newtonSteps = 0;
+int bounces = 0;
+int grazes = 0;
+
+int main(void)
+{
+    initialize();
+
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void initialize(void) {
+    InitWindow(screenWidth, screenHeight, "raylib");
+    SetTargetFPS(60);
+
+    randomCurves();
+
+    for (int i = 0; i < NUM_BULLETS; i++) {
+        float angle = GetRandomValue(0, 359) * DEG2RAD;
+        float speed = GetRandomValue(20, 40) / 10.0f;
+
+        bullets[i].position = (Vector2) {GetRandomValue(0, screenWidth), GetRandomValue(0, screenHeight)};
+        bullets[i].velocity = (Vector2) {cos(angle) * speed, sin(angle) * speed};
+        bullets[i].grazing = false;
+    }
+}
+
+void update(void) {
+    if (IsKeyPressed(KEY_R)) { randomCurves(); }
+    if (IsKeyPressed(KEY_B)) { bruteForce = !bruteForce; }
+    if (IsKeyPressed(KEY_G)) { useBroadPhase = !useBroadPhase; }
+
+    candidatesTested = 0;
+    piecesVisited = 0;
+    newtonSteps = 0;
+    bounces = 0;
+    grazes = 0;
+
+    double start = GetTime();
+
+    for (int i = 0; i < NUM_BULLETS; i++) {
+        Vector2 a = bullets[i].position;
+        Vector2 b = (Vector2) {a.x + bullets[i].velocity.x, a.y + bullets[i].velocity.y};
+
+        int count = gatherCurves(MIN(a.x, b.x) - GRAZE_RADIUS, MIN(a.y, b.y) - GRAZE_RADIUS,
+                                 MAX(a.x, b.x) + GRAZE_RADIUS, MAX(a.y, b.y) + GRAZE_RADIUS);
+
+        // Did this step cross a curve? Keep the first crossing along the step (smallest u)
+        float hitU = 2;
+        float hitT = 0;
+        int hitCurve = -1;
+
+        for (int k = 0; k < count; k++) {
+            bool hit = bruteForce ? segmentHitsSampled(candidates[k], a, b, &hitU, &hitT)
+                                  : segmentHitsCurve(candidates[k], a, b, &hitU, &hitT);
+            if (hit) {
+                hitCurve = candidates[k];
+            }
+        }
+
+        if (hitCurve >= 0) {
+            Vector2 *c = curves[hitCurve];
+            float u = 1 - hitT;
+
+            // Normal from the tangent 2(1-t)(c1 - c0) + 2t(c2 - c1), then reflect the velocity about it
+            Vector2 tangent = (Vector2) {2 * u * (c[1].x - c[0].x) + 2 * hitT * (c[2].x - c[1].x),
+                                         2 * u * (c[1].y - c[0].y) + 2 * hitT * (c[2].y - c[1].y)};
+            float len = sqrtf(tangent.x * tangent.x + tangent.y * tangent.y);
+
+            if (len > 0) {
+                Vector2 n = (Vector2) {-tangent.y / len, tangent.x / len};
+                float vn = bullets[i].velocity.x * n.x + bullets[i].velocity.y * n.y;
+
+                bullets[i].velocity.x -= 2 * vn * n.x;
+                bullets[i].velocity.y -= 2 * vn * n.y;
+
+                // Put it back on the side it came from, just off the curve
+                Vector2 hitPt = (Vector2) {a.x + (b.x - a.x) * hitU, a.y + (b.y - a.y) * hitU};
+                float side = ((a.x - hitPt.x) * n.x + (a.y - hitPt.y) * n.y > 0) ? 0.5f : -0.5f;
+                b = (Vector2) {hitPt.x + n.x * side, hitPt.y + n.y * side};
+            }
+
+            bounces++;
+        }
+
+        // Wrap around the screen edges
+        if (b.x < 0) { b.x += screenWidth; }
+        if (b.x >= screenWidth) { b.x -= screenWidth; }
+        if (b.y < 0) { b.y += screenHeight; }
+        if (b.y >= screenHeight) { b.y -= screenHeight; }
+
+        bullets[i].position = b;
+
+        // Is it close to a curve? Only needs to know if anything is within GRAZE_RADIUS, so that is the starting best
+        float bestDistSq = GRAZE_RADIUS * GRAZE_RADIUS;
+        float bestT = 0;
+        bullets[i].grazing = false;
+
+        for (int k = 0; k < count; k++) {
+            bool closer = bruteForce ? nearestSampled(candidates[k], b, &bestDistSq, &bestT)
+                                     : nearestOnCurve(candidates[k], b, &bestDistSq, &bestT);
+            if (closer) {
+                bullets[i].grazing = true;
+            }
+        }
+
+        if (bullets[i].grazing) {
+            grazes++;
+        }
+    }
+
+    // Mouse, nearest point on any curve within MOUSE_RADIUS
+    Vector2 mouse = GetMousePosition();
+    int count = gatherCurves(mouse.x - MOUSE_RADIUS, mouse.y - MOUSE_RADIUS, mouse.x + MOUSE_RADIUS, mouse.y + MOUSE_RADIUS);
+    float bestDistSq = MOUSE_RADIUS * MOUSE_RADIUS;
+    float bestT = 0;
+    int bestCurve = -1;
+
+    for (int k = 0; k < count; k++) {
+        bool closer = bruteForce ? nearestSampled(candidates[k], mouse, &bestDistSq, &bestT)
+                                 : nearestOnCurve(candidates[k], mouse, &bestDistSq, &bestT);
+        if (closer) {
+            bestCurve = candidates[k];
+        }
+    }
+
+    mouseFound = (bestCurve >= 0);
+    if (mouseFound) {
+        // bestT belongs to bestCurve, a later curve only changes it if it was closer
+        Vector2 *c = curves[bestCurve];
+        float u = 1 - bestT;
+        mouseNearest.x = u * u * c[0].x + 2 * u * bestT * c[1].x + bestT * bestT * c[2].x;
+        mouseNearest.y = u * u * c[0].y + 2 * u * bestT * c[1].y + bestT * bestT * c[2].y;
+    }
+
+    queryMs = (GetTime() - start) * 1000.0;
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(RAYWHITE);
+
+        for (int i = 0; i < NUM_CURVES; i++) {
+            DrawLineBezierQuad(curves[i][0], curves[i][2], curves[i][1], 2, DARKGRAY);
+        }
+
+        for (int i = 0; i < NUM_BULLETS; i++) {
+            DrawCircleV(bullets[i].position, 2, bullets[i].grazing ? RED : SKYBLUE);
+        }
+
+        if (mouseFound) {
+            DrawLineV(GetMousePosition(), mouseNearest, ORANGE);
+            DrawCircleV(mouseNearest, 5, ORANGE);
+        }
+
+        DrawRectangle(0, 0, 440, 160, Fade(RAYWHITE, 0.85f));
+        DrawText(TextFormat("%d queries: %.3f ms", NUM_BULLETS * 2 + 1, queryMs), 10, 10, 20, BLACK);
+        DrawText(TextFormat("%s [B], broad phase %s [G]", bruteForce ? "sampled" : "subdivide + newton",
+                            useBroadPhase ? "on" : "off"), 10, 35, 20, BLACK);
+        DrawText(TextFormat("curves tested: %d", candidatesTested), 10, 60, 20, BLACK);
+        DrawText(TextFormat("pieces: %d, newton steps: %d", piecesVisited, newtonSteps), 10, 85, 20, BLACK);
+        DrawText(TextFormat("bounces: %d, grazing: %d", bounces, grazes), 10, 110, 20, BLACK);
+        DrawFPS(10, 135);
+
+    EndDrawing();
+}
+
+// Start and end somewhere on screen, control point off to one side of the middle
+void randomCurves(void) {
+    for (int i = 0; i < NUM_CURVES; i++) {
+        Vector2 start = (Vector2) {GetRandomValue(0, screenWidth), GetRandomValue(0, screenHeight)};
+        float angle = GetRandomValue(0, 359) * DEG2RAD;
+        float length = GetRandomValue(80, 200);
+        float bend = GetRandomValue(-100, 100);
+
+        Vector2 end = (Vector2) {start.x + cos(angle) * length, start.y + sin(angle) * length};
+        Vector2 mid = (Vector2) {(start.x + end.x) / 2, (start.y + end.y) / 2};
+
+        curves[i][0] = start;
+        curves[i][1] = (Vector2) {mid.x - sin(angle) * bend, mid.y + cos(angle) * bend};
+        curves[i][2] = end;
+
+        float minX = MIN(curves[i][0].x, MIN(curves[i][1].x, curves[i][2].x));
+        float minY = MIN(curves[i][0].y, MIN(curves[i][1].y, curves[i][2].y));
+        float maxX = MAX(curves[i][0].x, MAX(curves[i][1].x, curves[i][2].x));
+        float maxY = MAX(curves[i][0].y, MAX(curves[i][1].y, curves[i][2].y));
+        curveBox[i] = (Rectangle) {minX, minY, maxX - minX, maxY - minY};
+    }
+
+    buildBroadPhase();
+}
+
+// Count how many curves go in each cell, turn the counts into start offsets, then fill
+void buildBroadPhase(void) {
+    static int fill[GRID_WIDTH * GRID_HEIGHT];
+
+    for (int c = 0; c <= GRID_WIDTH * GRID_HEIGHT; c++) {
+        cellStart[c] = 0;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < NUM_CURVES; i++) {
+            int x0 = Clamp(curveBox[i].x / BROAD_CELL, 0, GRID_WIDTH - 1);
+            int y0 = Clamp(curveBox[i].y / BROAD_CELL, 0, GRID_HEIGHT - 1);
+            int x1 = Clamp((curveBox[i].x + curveBox[i].width) / BROAD_CELL, 0, GRID_WIDTH - 1);
+            int y1 = Clamp((curveBox[i].y + curveBox[i].height) / BROAD_CELL, 0, GRID_HEIGHT - 1);
+
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    int cell = y * GRID_WIDTH + x;
+
+                    if (pass == 0) {
+                        cellStart[cell + 1]++;
+                    }
+                    else if (fill[cell] < cellStart[cell + 1]) {
+                        cellCurves[fill[cell]++] = i;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0) {
+            for (int c = 0; c < GRID_WIDTH * GRID_HEIGHT; c++) {
+                cellStart[c + 1] += cellStart[c];
+
+                // Never more than MAX_CELL_ENTRIES, a curve that doesn't fit just gets left out of that cell
+                if (cellStart[c + 1] > MAX_CELL_ENTRIES) {
+                    cellStart[c + 1] = MAX_CELL_ENTRIES;
+                }
+
+                fill[c] = cellStart[c];
+            }
+        }
+    }
+}
+
+// Fills candidates[] with every curve whose box overlaps the query box, each one once
+int gatherCurves(float minX, float minY, float maxX, float maxY) {
+    int count = 0;
+
+    if (!useBroadPhase) {
+        for (int i = 0; i < NUM_CURVES; i++) {
+            candidates[count++] = i;
+        }
+
+        candidatesTested += count;
+        return count;
+    }
+
+    stamp++;
+
+    int x0 = Clamp(minX / BROAD_CELL, 0, GRID_WIDTH - 1);
+    int y0 = Clamp(minY / BROAD_CELL, 0, GRID_HEIGHT - 1);
+    int x1 = Clamp(maxX / BROAD_CELL, 0, GRID_WIDTH - 1);
+    int y1 = Clamp(maxY / BROAD_CELL, 0, GRID_HEIGHT - 1);
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y * GRID_WIDTH + x;
+
+            for (int e = cellStart[cell]; e < cellStart[cell + 1]; e++) {
+                int curve = cellCurves[e];
+
+                if (curveStamp[curve] == stamp) {
+                    continue;
+                }
+                curveStamp[curve] = stamp;
+
+                Rectangle box = curveBox[curve];
+                if (box.x > maxX || box.x + box.width < minX || box.y > maxY || box.y + box.height < minY) {
+                    continue;
+                }
+
+                candidates[count++] = curve;
+            }
+        }
+    }
+
+    candidatesTested += count;
+    return count;
+}
+
+// Squared distance from p to the box around a piece's control points, 0 if p is inside
+float hullDistSq(const Vector2 *c, Vector2 p) {
+    float minX = MIN(c[0].x, MIN(c[1].x, c[2].x));
+    float minY = MIN(c[0].y, MIN(c[1].y, c[2].y));
+    float maxX = MAX(c[0].x, MAX(c[1].x, c[2].x));
+    float maxY = MAX(c[0].y, MAX(c[1].y, c[2].y));
+
+    float dx = MAX(MAX(minX - p.x, 0), p.x - maxX);
+    float dy = MAX(MAX(minY - p.y, 0), p.y - maxY);
+
+    return dx * dx + dy * dy;
+}
+
+// How far the control point is from the middle of the chord, 0 for a straight line
+bool isFlat(const Piece *piece) {
+    float dx = piece->c[1].x - (piece->c[0].x + piece->c[2].x) / 2;
+    float dy = piece->c[1].y - (piece->c[0].y + piece->c[2].y) / 2;
+
+    return (dx * dx + dy * dy < FLAT_EPSILON * FLAT_EPSILON) || piece->depth >= MAX_DEPTH;
+}
+
+// de Casteljau at t = 0.5
+void splitPiece(const Piece *piece, Piece *left, Piece *right) {
+    Vector2 a = (Vector2) {(piece->c[0].x + piece->c[1].x) / 2, (piece->c[0].y + piece->c[1].y) / 2};
+    Vector2 b = (Vector2) {(piece->c[1].x + piece->c[2].x) / 2, (piece->c[1].y + piece->c[2].y) / 2};
+    Vector2 mid = (Vector2) {(a.x + b.x) / 2, (a.y + b.y) / 2};
+    float tm = (piece->t0 + piece->t1) / 2;
+
+    *left = (Piece) {{piece->c[0], a, mid}, piece->t0, tm, piece->depth + 1};
+    *right = (Piece) {{mid, b, piece->c[2]}, tm, piece->t1, piece->depth + 1};
+}
+
+/*
+If some point on the curve is closer to p than sqrt(*bestDistSq), sets *bestDistSq and *bestT to it and returns true.
+Pieces are split nearest half first, so the best distance shrinks quickly and most of the far halves never get split.
+*/
+bool nearestOnCurve(int curve, Vector2 p, float *bestDistSq, float *bestT) {
+    Vector2 *c = curves[curve];
+    Piece stack[MAX_DEPTH + 2];
+    int top = 0;
+    float guessT = -1;
+    float guessDistSq = *bestDistSq;
+
+    stack[top++] = (Piece) {{c[0], c[1], c[2]}, 0, 1, 0};
+
+    while (top > 0) {
+        Piece piece = stack[--top];
+
+        if (hullDistSq(piece.c, p) >= guessDistSq) {
+            continue;
+        }
+
+        piecesVisited++;
+
+        if (isFlat(&piece)) {
+            // Closest point on the chord
+            Vector2 d = (Vector2) {piece.c[2].x - piece.c[0].x, piece.c[2].y - piece.c[0].y};
+            float lenSq = d.x * d.x + d.y * d.y;
+            float s = (lenSq > 0) ? Clamp(((p.x - piece.c[0].x) * d.x + (p.y - piece.c[0].y) * d.y) / lenSq, 0, 1) : 0;
+            float dx = piece.c[0].x + d.x * s - p.x;
+            float dy = piece.c[0].y + d.y * s - p.y;
+
+            if (dx * dx + dy * dy < guessDistSq) {
+                guessDistSq = dx * dx + dy * dy;
+                guessT = piece.t0 + (piece.t1 - piece.t0) * s;
+            }
+            continue;
+        }
+
+        Piece left, right;
+        splitPiece(&piece, &left, &right);
+
+        // Push the far one first so the near one is popped first
+        if (hullDistSq(left.c, p) < hullDistSq(right.c, p)) {
+            stack[top++] = right;
+            stack[top++] = left;
+        }
+        else {
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+    }
+
+    if (guessT < 0) {
+        return false;
+    }
+
+    /*
+    Newton on f(t) = (B(t) - p) . B'(t), which is 0 where p - B(t) is perpendicular to the curve
+        f'(t) = B'(t) . B'(t) + (B(t) - p) . B''(t), and B''(t) = 2(c0 - 2c1 + c2) doesn't depend on t
+    */
+    float t = guessT;
+    Vector2 dd = (Vector2) {2 * (c[0].x - 2 * c[1].x + c[2].x), 2 * (c[0].y - 2 * c[1].y + c[2].y)};
+
+    for (int k = 0; k < NEWTON_STEPS; k++) {
+        float u = 1 - t;
+        float bx = u * u * c[0].x + 2 * u * t * c[1].x + t * t * c[2].x - p.x;
+        float by = u * u * c[0].y + 2 * u * t * c[1].y + t * t * c[2].y - p.y;
+        float dx = 2 * u * (c[1].x - c[0].x) + 2 * t * (c[2].x - c[1].x);
+        float dy = 2 * u * (c[1].y - c[0].y) + 2 * t * (c[2].y - c[1].y);
+
+        float f = bx * dx + by * dy;
+        float fp = dx * dx + dy * dy + bx * dd.x + by * dd.y;
+
+        newtonSteps++;
+
+        if (fp <= 0) {
+            break;
+        }
+
+        t = Clamp(t - f / fp, 0, 1);
+    }
+
+    // Newton only ever gets to keep its answer if it really is closer than the chord guess
+    float u = 1 - t;
+    float dx = u * u * c[0].x + 2 * u * t * c[1].x + t * t * c[2].x - p.x;
+    float dy = u * u * c[0].y + 2 * u * t * c[1].y + t * t * c[2].y - p.y;
+
+    if (dx * dx + dy * dy < guessDistSq) {
+        guessDistSq = dx * dx + dy * dy;
+        guessT = t;
+    }
+
+    *bestDistSq = guessDistSq;
+    *bestT = guessT;
+
+    return true;
+}
+
+// z of the cross product of (p - a) and d, which side of the line through a (along d) p is on
+float sideOf(Vector2 p, Vector2 a, Vector2 d) {
+    return (p.x - a.x) * d.y - (p.y - a.y) * d.x;
+}
+
+/*
+If the segment a -> b crosses the curve before *bestU (0 = at a, 1 = at b), sets *bestU and *bestT and returns true.
+A piece is thrown away if its box misses the segment's box, or if all 3 control points are on the same side of the line,
+since then the whole piece is on that side too.
+*/
+bool segmentHitsCurve(int curve, Vector2 a, Vector2 b, float *bestU, float *bestT) {
+    Vector2 *c = curves[curve];
+    Vector2 d = (Vector2) {b.x - a.x, b.y - a.y};
+    Piece stack[REFINE_DEPTH + 2];
+    int top = 0;
+    bool found = false;
+
+    float segMinX = MIN(a.x, b.x), segMaxX = MAX(a.x, b.x);
+    float segMinY = MIN(a.y, b.y), segMaxY = MAX(a.y, b.y);
+
+    stack[top++] = (Piece) {{c[0], c[1], c[2]}, 0, 1, 0};
+
+    while (top > 0) {
+        Piece piece = stack[--top];
+
+        if (MAX(piece.c[0].x, MAX(piece.c[1].x, piece.c[2].x)) < segMinX ||
+            MIN(piece.c[0].x, MIN(piece.c[1].x, piece.c[2].x)) > segMaxX ||
+            MAX(piece.c[0].y, MAX(piece.c[1].y, piece.c[2].y)) < segMinY ||
+            MIN(piece.c[0].y, MIN(piece.c[1].y, piece.c[2].y)) > segMaxY) {
+            continue;
+        }
+
+        float s0 = sideOf(piece.c[0], a, d);
+        float s1 = sideOf(piece.c[1], a, d);
+        float s2 = sideOf(piece.c[2], a, d);
+
+        if ((s0 > 0 && s1 > 0 && s2 > 0) || (s0 < 0 && s1 < 0 && s2 < 0)) {
+            continue;
+        }
+
+        piecesVisited++;
+
+        if (!isFlat(&piece)) {
+            Piece left, right;
+            splitPiece(&piece, &left, &right);
+            stack[top++] = right;
+            stack[top++] = left;
+            continue;
+        }
+
+        // Chord against the segment, s along the chord and u along the segment
+        Vector2 e = (Vector2) {piece.c[2].x - piece.c[0].x, piece.c[2].y - piece.c[0].y};
+        float denom = d.x * e.y - d.y * e.x;
+
+        if (denom == 0) {
+            continue;
+        }
+
+        float wx = piece.c[0].x - a.x;
+        float wy = piece.c[0].y - a.y;
+        float s = (wx * d.y - wy * d.x) / denom;
+
+        if (s < -0.01f || s > 1.01f) {
+            continue;
+        }
+
+        // Newton on g(t) = side of B(t) relative to the segment's line, g'(t) = side of B'(t)
+        float t = Clamp(piece.t0 + (piece.t1 - piece.t0) * s, 0, 1);
+
+        for (int k = 0; k < NEWTON_STEPS; k++) {
+            float w = 1 - t;
+            Vector2 pt = (Vector2) {w * w * c[0].x + 2 * w * t * c[1].x + t * t * c[2].x,
+                                    w * w * c[0].y + 2 * w * t * c[1].y + t * t * c[2].y};
+            Vector2 tan = (Vector2) {2 * w * (c[1].x - c[0].x) + 2 * t * (c[2].x - c[1].x),
+                                     2 * w * (c[1].y - c[0].y) + 2 * t * (c[2].y - c[1].y)};
+            float g = sideOf(pt, a, d);
+            float gp = tan.x * d.y - tan.y * d.x;
+
+            newtonSteps++;
+
+            if (gp == 0) {
+                break;
+            }
+
+            t = Clamp(t - g / gp, 0, 1);
+        }
+
+        float w = 1 - t;
+        Vector2 pt = (Vector2) {w * w * c[0].x + 2 * w * t * c[1].x + t * t * c[2].x,
+                                w * w * c[0].y + 2 * w * t * c[1].y + t * t * c[2].y};
+        float lenSq = d.x * d.x + d.y * d.y;
+
+        // sideOf is the distance to the line times |d|. If Newton stalled (gp == 0, or clamped into an end) or just didn't
+        // get there in NEWTON_STEPS, the chord said there's a crossing somewhere in here, so split and look closer
+        if (fabsf(sideOf(pt, a, d)) > HIT_EPSILON * sqrtf(lenSq)) {
+            if (piece.depth < REFINE_DEPTH) {
+                Piece left, right;
+                splitPiece(&piece, &left, &right);
+                stack[top++] = right;
+                stack[top++] = left;
+            }
+            continue;
+        }
+
+        float u = (lenSq > 0) ? ((pt.x - a.x) * d.x + (pt.y - a.y) * d.y) / lenSq : 0;
+
+        if (u >= 0 && u <= 1 && u < *bestU) {
+            *bestU = u;
+            *bestT = t;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+// The slow way, for comparing: BRUTE_SAMPLES points along the curve, take the closest
+bool nearestSampled(int curve, Vector2 p, float *bestDistSq, float *bestT) {
+    Vector2 *c = curves[curve];
+    bool found = false;
+
+    for (int i = 0; i <= BRUTE_SAMPLES; i++) {
+        float t = (float) i / BRUTE_SAMPLES;
+        float u = 1 - t;
+        float dx = u * u * c[0].x + 2 * u * t * c[1].x + t * t * c[2].x - p.x;
+        float dy = u * u * c[0].y + 2 * u * t * c[1].y + t * t * c[2].y - p.y;
+
+        if (dx * dx + dy * dy < *bestDistSq) {
+            *bestDistSq = dx * dx + dy * dy;
+            *bestT = t;
+            found = true;
+        }
+    }
+
+    piecesVisited += BRUTE_SAMPLES;
+    return found;
+}
+
+// The slow way, for comparing: the segment against every one of the BRUTE_SAMPLES little lines along the curve
+bool segmentHitsSampled(int curve, Vector2 a, Vector2 b, float *bestU, float *bestT) {
+    Vector2 *c = curves[curve];
+    Vector2 d = (Vector2) {b.x - a.x, b.y - a.y};
+    Vector2 prev = c[0];
+    bool found = false;
+
+    for (int i = 1; i <= BRUTE_SAMPLES; i++) {
+        float t = (float) i / BRUTE_SAMPLES;
+        float w = 1 - t;
+        Vector2 cur = (Vector2) {w * w * c[0].x + 2 * w * t * c[1].x + t * t * c[2].x,
+                                 w * w * c[0].y + 2 * w * t * c[1].y + t * t * c[2].y};
+        Vector2 e = (Vector2) {cur.x - prev.x, cur.y - prev.y};
+        float denom = d.x * e.y - d.y * e.x;
+
+        if (denom != 0) {
+            float wx = prev.x - a.x;
+            float wy = prev.y - a.y;
+            float s = (wx * d.y - wy * d.x) / denom;
+            float u = (wx * e.y - wy * e.x) / denom;
+
+            if (s >= 0 && s <= 1 && u >= 0 && u <= 1 && u < *bestU) {
+                *bestU = u;
+                *bestT = t - (1 - s) / BRUTE_SAMPLES;
+                found = true;
+            }
+        }
+
+        prev = cur;
+    }
+
+    piecesVisited += BRUTE_SAMPLES;
+    return found;
+}
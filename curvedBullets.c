@@ -0,0 +1,307 @@
+/*
+Curved Bullets - October 2026
+
+An updated version of "borderOfWaveAndParticle.c"
+Bullets can now follow bezier paths instead of only flying straight.
+
+Evaluating the bezier for every bullet every tick would cost a few times more than a straight line, so instead
+every path is baked once at startup into a table of points PATH_STEP pixels apart along the curve (by arc length,
+so bullets keep an even speed along the curve instead of bunching up where the control points are close together).
+A bullet only keeps which path it is on, how far along it is and how fast it is going, plus where it was fired from and
+which way. Updating it is then one table lookup, a lerp between two neighbouring points and the same rotation we already
+use for the targets. Past the end of the table a bullet keeps going straight along the path's last direction at the same
+speed, until it leaves the screen like any other bullet.
+
+Paths are written with +x as "forwards", and get rotated to whatever direction the bullet was fired in.
+
+Controls:
+    0           every target fires a different path
+    1 - 4       every target fires the same path
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+void setTargets(void);
+void bakePath(int path, Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3);
+void shoot(int targIndex, int path);
+void resetBullet(int index);
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define NUM_TARGETS 5
+#define MAX_BULLETS 4000
+#define MAX_VELOCITY 5
+
+#define NUM_PATHS 4
+#define PATH_STEP 2.0f
+#define PATH_SAMPLES 1024
+
+// How finely the curve is cut up to measure its length while baking
+#define BAKE_SUBDIVISIONS 4096
+
+typedef enum PathType {
+    PATH_HOOK_LEFT,
+    PATH_HOOK_RIGHT,
+    PATH_WAVE,
+    PATH_LOOP
+} PathType;
+
+typedef struct {
+    Vector2 origin;
+    Vector2 direction;
+    Vector2 position;
+    float distance;
+    float speed;
+    int path;
+    bool isActive;
+} Bullet;
+
+// Points PATH_STEP apart along each path, starting at (0, 0)
+// Every path gets its own row, so a bullet only ever reads one small contiguous run of it
+Vector2 pathTable[NUM_PATHS][PATH_SAMPLES];
+float pathLength[NUM_PATHS];
+// Unit direction of the last piece of each path, what a bullet keeps flying along once it runs off the end
+Vector2 pathEndDirection[NUM_PATHS];
+
+Vector2 targets[NUM_TARGETS];
+Bullet bullets[MAX_BULLETS];
+
+int curBullet;
+
+float rotationAngle = 0;
+float deltaRAngle = 0.225f;
+
+// -1 is every target firing a different path
+int pathMode = -1;
+
+int frameCounter = 0;
+double updateMs = 0;
+
+int main() {
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    setTargets();
+
+    // Quadratic curves (start, control, end like bezier_2pts.c) are turned into cubics with
+    // c1 = start + 2/3 (control - start), c2 = end + 2/3 (control - end)
+    bakePath(PATH_HOOK_LEFT, (Vector2) {0, 0}, (Vector2) {400, 0}, (Vector2) {600, -133}, (Vector2) {600, -400});
+    bakePath(PATH_HOOK_RIGHT, (Vector2) {0, 0}, (Vector2) {400, 0}, (Vector2) {600, 133}, (Vector2) {600, 400});
+    bakePath(PATH_WAVE, (Vector2) {0, 0}, (Vector2) {300, -250}, (Vector2) {400, 250}, (Vector2) {800, 0});
+    bakePath(PATH_LOOP, (Vector2) {0, 0}, (Vector2) {600, -500}, (Vector2) {-300, -500}, (Vector2) {700, 100});
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        resetBullet(i);
+    }
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_ZERO)) { pathMode = -1; }
+    for (int p = 0; p < NUM_PATHS; p++) {
+        if (IsKeyPressed(KEY_ONE + p)) { pathMode = p; }
+    }
+
+    double start = GetTime();
+
+    // Update bullets ====================================================
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!bullets[i].isActive) {
+            continue;
+        }
+
+        bullets[i].distance += bullets[i].speed;
+
+        int path = bullets[i].path;
+        float localX, localY;
+
+        if (bullets[i].distance >= pathLength[path]) {
+            // Past the end of the path, carry on in a straight line from the last sample
+            Vector2 end = pathTable[path][(int) (pathLength[path] / PATH_STEP)];
+            float past = bullets[i].distance - pathLength[path];
+
+            localX = end.x + pathEndDirection[path].x * past;
+            localY = end.y + pathEndDirection[path].y * past;
+        }
+        else {
+            // distance < pathLength, so a is never the last sample and there is always a b
+            float sample = bullets[i].distance / PATH_STEP;
+            int a = (int) sample;
+
+            Vector2 pa = pathTable[path][a];
+            Vector2 pb = pathTable[path][a + 1];
+            float t = sample - a;
+
+            localX = pa.x + (pb.x - pa.x) * t;
+            localY = pa.y + (pb.y - pa.y) * t;
+        }
+
+        // Rotate the path so that +x points the way the bullet was fired
+        Vector2 d = bullets[i].direction;
+        bullets[i].position.x = bullets[i].origin.x + (localX * d.x) - (localY * d.y);
+        bullets[i].position.y = bullets[i].origin.y + (localX * d.y) + (localY * d.x);
+
+        // Test for out-of-bounds bullets
+        if (bullets[i].position.x > SCREEN_WIDTH / 2 || bullets[i].position.x < -SCREEN_WIDTH / 2 ||
+            bullets[i].position.y > SCREEN_HEIGHT / 2 || bullets[i].position.y < -SCREEN_HEIGHT / 2) {
+            resetBullet(i);
+        }
+    }
+
+    updateMs = (GetTime() - start) * 1000.0;
+
+    // Shoot the bullets, every other frame so the curves don't turn into a solid wall
+    frameCounter++;
+    if (frameCounter % 2 == 0) {
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            shoot(i, (pathMode < 0) ? (i % NUM_PATHS) : pathMode);
+        }
+    }
+
+    // Update targets ====================================================
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        // This is just an expanded rotation matrix multiplication
+        float xComponent = (targets[i].x * cos(rotationAngle * DEG2RAD)) -
+                           (targets[i].y * sin(rotationAngle * DEG2RAD));
+        float yComponent = (targets[i].x * sin(rotationAngle * DEG2RAD)) +
+                           (targets[i].y * cos(rotationAngle * DEG2RAD));
+        targets[i] = (Vector2) {xComponent, yComponent};
+    }
+
+    rotationAngle += deltaRAngle;
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            DrawCircle(targets[i].x + SCREEN_WIDTH / 2, targets[i].y + SCREEN_HEIGHT / 2, 5, YELLOW);
+        }
+
+        const Color pathColors[NUM_PATHS] = {PURPLE, SKYBLUE, LIME, ORANGE};
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                Vector2 tempPos = (Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2};
+                DrawCircleV(tempPos, 5, pathColors[bullets[i].path]);
+            }
+        }
+
+        DrawText((pathMode < 0) ? "paths: mixed [0-4]" : TextFormat("paths: %d [0-4]", pathMode + 1), 10, 10, 20, WHITE);
+        DrawText(TextFormat("update: %.3f ms", updateMs), 10, 35, 20, WHITE);
+
+    EndDrawing();
+}
+
+// Just your classic "n circular points made from rotating [1; 0] with a rotation matrix"
+void setTargets(void) {
+    float deltaAngle = 360 / NUM_TARGETS;
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float angle = (deltaAngle * i) * DEG2RAD;
+
+        targets[i].x = cos(angle);
+        targets[i].y = sin(angle);
+    }
+}
+
+/*
+Bakes a cubic bezier into pathTable[path].
+First the curve is cut into BAKE_SUBDIVISIONS short straight pieces, then we walk along them and drop a sample
+every PATH_STEP pixels of length. Anything past PATH_SAMPLES * PATH_STEP is cut off.
+*/
+void bakePath(int path, Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3) {
+    Vector2 prev = p0;
+    float walked = 0;
+    int count = 1;
+
+    pathTable[path][0] = p0;
+
+    for (int s = 1; s <= BAKE_SUBDIVISIONS && count < PATH_SAMPLES; s++) {
+        float t = (float) s / BAKE_SUBDIVISIONS;
+        float u = 1 - t;
+
+        // Bernstein form of the cubic
+        Vector2 cur;
+        cur.x = (u * u * u * p0.x) + (3 * u * u * t * p1.x) + (3 * u * t * t * p2.x) + (t * t * t * p3.x);
+        cur.y = (u * u * u * p0.y) + (3 * u * u * t * p1.y) + (3 * u * t * t * p2.y) + (t * t * t * p3.y);
+
+        float piece = sqrt(pow(cur.x - prev.x, 2) + pow(cur.y - prev.y, 2));
+
+        // Drop every sample that falls inside this piece
+        while (count < PATH_SAMPLES && walked + piece >= count * PATH_STEP) {
+            float along = (piece > 0) ? (count * PATH_STEP - walked) / piece : 0;
+            pathTable[path][count] = (Vector2) {prev.x + (cur.x - prev.x) * along, prev.y + (cur.y - prev.y) * along};
+            count++;
+        }
+
+        walked += piece;
+        prev = cur;
+    }
+
+    pathLength[path] = (count - 1) * PATH_STEP;
+
+    // The last two samples are PATH_STEP apart, a path too short to have two just points along +x
+    if (count > 1) {
+        Vector2 last = pathTable[path][count - 1];
+        Vector2 before = pathTable[path][count - 2];
+        pathEndDirection[path] = (Vector2) {(last.x - before.x) / PATH_STEP, (last.y - before.y) / PATH_STEP};
+    }
+    else {
+        pathEndDirection[path] = (Vector2) {1, 0};
+    }
+
+    // Pad the rest so a lookup past the end is still inside the table
+    for (int i = count; i < PATH_SAMPLES; i++) {
+        pathTable[path][i] = pathTable[path][count - 1];
+    }
+}
+
+void shoot(int targIndex, int path) {
+    float hyp = sqrt(pow(targets[targIndex].x, 2) + pow(targets[targIndex].y, 2));
+
+    bullets[curBullet].isActive = true;
+    bullets[curBullet].origin = targets[targIndex];
+    bullets[curBullet].position = targets[targIndex];
+    bullets[curBullet].direction = (Vector2) {targets[targIndex].x / hyp, targets[targIndex].y / hyp};
+    bullets[curBullet].distance = 0;
+    bullets[curBullet].speed = MAX_VELOCITY;
+    bullets[curBullet].path = path;
+
+    curBullet++;
+    if (curBullet >= MAX_BULLETS) {
+        curBullet = 0;
+    }
+}
+
+void resetBullet(int index) {
+    bullets[index].origin = (Vector2) {0, 0};
+    bullets[index].direction = (Vector2) {1, 0};
+    bullets[index].position = (Vector2) {0, 0};
+    bullets[index].distance = 0;
+    bullets[index].speed = 0;
+    bullets[index].isActive = false;
+}
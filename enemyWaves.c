@@ -0,0 +1,439 @@
+/*
+    Enemy waves - an updated version of mouseProjectiles.c with thousands of shooters firing back at you
+
+    mouseProjectiles.c has one player, one frameCounter and one curBullet, which is fine for one shooter
+    here every shooter has its own aim, cooldown and fire rate, kept as one array per field (shooterX[], shooterCooldown[], ...)
+    instead of an array of structs, so every per tick step is a plain loop over a few float arrays that the compiler can vectorize:
+        1. move: every shooter eases towards its station
+        2. aim: direction from the shooter to the player (+ its own aim offset so they don't all hit the same pixel)
+        3. cooldown: count down, and mark the ones that hit 0 (they reset to their fire rate in the same loop)
+    the loops run SHOOTER_BATCH shooters at a time, and after each batch the marked ones are collected into a fire list
+    then the whole fire list goes into the shared bullet pool in one go: reserve count slots at curBullet and write them in
+    (at most two runs, if it wraps around the end of the pool)
+
+    the bullets are one array per field as well, and their update has no branches either
+
+    checked with gcc -O3 -fopt-info-vec: the shooter loop, the bullet update and the hit count all vectorize
+    (the shooter loop needs -fno-math-errno or -ffast-math, otherwise sqrtf keeps it scalar because it might set errno)
+
+    WASD moves, hold left mouse to shoot like mouseProjectiles.c, your bullets kill shooters
+    N       send the next wave now (otherwise one comes every WAVE_TICKS)
+    UP/DOWN wave size
+    C       clear all shooters
+*/
+
+#include "raylib.h"
+
+#include <math.h>
+#include <stdbool.h>
+
+void initialize();
+void update();
+void draw();
+void spawnWave(int count);
+void removeShooter(int index);
+void fireBatch(int count);
+void getVelocities(int index);
+
+#define MAX_SHOOTERS 16384
+#define SHOOTER_BATCH 256
+#define MAX_ENEMY_BULLETS 65536
+#define ENEMY_BULLET_VELOCITY 3.0f
+#define SHOOTER_SIZE 6
+#define WAVE_TICKS 600
+
+#define MAX_BULLETS 50
+#define BULLET_VELOCITY 25
+
+typedef struct Player {
+    Rectangle rect;
+    Vector2 velocity;
+    Color color;
+} Player;
+
+typedef struct Bullet {
+    Rectangle rect;
+    Color color;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+const int screenWidth = 1280;
+const int screenHeight = 720;
+
+Player player;
+Bullet bullets[MAX_BULLETS];
+
+int frameCounter = 0;
+int curBullet = 0;
+
+// Shooters, one array per field
+float shooterX[MAX_SHOOTERS];
+float shooterY[MAX_SHOOTERS];
+float stationX[MAX_SHOOTERS];
+float stationY[MAX_SHOOTERS];
+float aimOffsetX[MAX_SHOOTERS];
+float aimOffsetY[MAX_SHOOTERS];
+float aimX[MAX_SHOOTERS];
+float aimY[MAX_SHOOTERS];
+int shooterCooldown[MAX_SHOOTERS];
+int shooterFireRate[MAX_SHOOTERS];
+int shooterReady[MAX_SHOOTERS];
+int numShooters = 0;
+
+// Indices of the shooters firing this tick
+int fireList[MAX_SHOOTERS];
+int numFiring = 0;
+
+// Enemy bullet pool, shared by every shooter
+float enemyX[MAX_ENEMY_BULLETS];
+float enemyY[MAX_ENEMY_BULLETS];
+float enemyVX[MAX_ENEMY_BULLETS];
+float enemyVY[MAX_ENEMY_BULLETS];
+float enemyActive[MAX_ENEMY_BULLETS];
+int curEnemyBullet = 0;
+
+int waveSize = 2000;
+int waveTimer = 0;
+int waveNumber = 0;
+
+// Stats
+int firedThisTick = 0;
+int liveEnemyBullets = 0;
+int hitsTaken = 0;
+int kills = 0;
+double shooterMs = 0;
+double enemyBulletMs = 0;
+
+int main()
+{
+    initialize();
+
+    while (!WindowShouldClose())
+    {
+        update();
+
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void initialize() {
+    InitWindow(screenWidth, screenHeight, "raylib");
+    SetTargetFPS(60);
+
+    // Initialize player
+    player.rect.width = 40;
+    player.rect.height = 40;
+    player.rect.x = screenWidth / 2 - (player.rect.width / 2);
+    player.rect.y = screenHeight / 2 - (player.rect.height / 2);
+    player.velocity = (Vector2) {5, 5};
+    player.color = BLACK;
+
+    // Initialize bullets
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        bullets[i].rect.width = 10;
+        bullets[i].rect.height = 10;
+        bullets[i].rect.x = player.rect.x + (player.rect.width / 2);
+        bullets[i].rect.y = player.rect.y + (player.rect.height / 2);
+
+        bullets[i].color = YELLOW;
+
+        bullets[i].velocity = (Vector2) {0, 0};
+        bullets[i].isActive = false;
+    }
+
+    for (int i = 0; i < MAX_ENEMY_BULLETS; i++) {
+        enemyX[i] = 0;
+        enemyY[i] = 0;
+        enemyVX[i] = 0;
+        enemyVY[i] = 0;
+        enemyActive[i] = 0;
+    }
+}
+
+void update() {
+
+    // Player movement
+    if (IsKeyDown(KEY_W)) { player.rect.y -= player.velocity.y; }
+    if (IsKeyDown(KEY_S)) { player.rect.y += player.velocity.y; }
+    if (IsKeyDown(KEY_A)) { player.rect.x -= player.velocity.x; }
+    if (IsKeyDown(KEY_D)) { player.rect.x += player.velocity.x; }
+
+    // Wall behaviour
+    if (player.rect.x <= 0) { player.rect.x = 0; }
+    if (player.rect.x + player.rect.width >= screenWidth) { player.rect.x = screenWidth - player.rect.width; }
+    if (player.rect.y <= 0) { player.rect.y = 0; }
+    if (player.rect.y + player.rect.height >= screenHeight) { player.rect.y = screenHeight - player.rect.height; }
+
+    if (IsKeyPressed(KEY_UP) && waveSize < MAX_SHOOTERS) { waveSize += 500; }
+    if (IsKeyPressed(KEY_DOWN) && waveSize > 500) { waveSize -= 500; }
+    if (IsKeyPressed(KEY_C)) { numShooters = 0; }
+
+    // Waves
+    waveTimer++;
+    if (waveTimer >= WAVE_TICKS || IsKeyPressed(KEY_N) || numShooters == 0) {
+        spawnWave(waveSize);
+        waveTimer = 0;
+    }
+
+    // Player shooting, same as mouseProjectiles.c
+    if (IsMouseButtonDown(0)) {
+        frameCounter++;
+
+        if (frameCounter > 60) { frameCounter = 1; }
+
+        if (frameCounter % 4 == 0) {
+            getVelocities(curBullet);
+            bullets[curBullet].isActive = true;
+
+            curBullet++;
+
+            if (curBullet == MAX_BULLETS) { curBullet = 0; }
+        }
+    }
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            bullets[i].rect.x += bullets[i].velocity.x;
+            bullets[i].rect.y += bullets[i].velocity.y;
+
+            // Player bullets against every shooter, there are only ever a handful of these
+            for (int s = 0; s < numShooters; s++) {
+                if (CheckCollisionPointRec((Vector2) {shooterX[s], shooterY[s]}, bullets[i].rect)) {
+                    removeShooter(s);
+                    s--;
+                    kills++;
+                }
+            }
+        }
+
+        if (!bullets[i].isActive) {
+            bullets[i].rect.x = player.rect.x + (player.rect.width / 2);
+            bullets[i].rect.y = player.rect.y + (player.rect.height / 2);
+        }
+
+        if (bullets[i].rect.x <= 0 || bullets[i].rect.x + bullets[i].rect.width >= screenWidth ||
+            bullets[i].rect.y <= 0 || bullets[i].rect.y + bullets[i].rect.height >= screenHeight) {
+            bullets[i].rect.x = player.rect.x + (player.rect.width / 2);
+            bullets[i].rect.y = player.rect.y + (player.rect.height / 2);
+            bullets[i].velocity = (Vector2) {0, 0};
+            bullets[i].isActive = false;
+        }
+    }
+
+    // Shooters ==========================================================
+    double start = GetTime();
+
+    float playerX = player.rect.x + (player.rect.width / 2);
+    float playerY = player.rect.y + (player.rect.height / 2);
+
+    firedThisTick = 0;
+
+    for (int base = 0; base < numShooters; base += SHOOTER_BATCH) {
+        int end = (base + SHOOTER_BATCH < numShooters) ? base + SHOOTER_BATCH : numShooters;
+
+        // Move, aim and count down, no branches in here
+        for (int i = base; i < end; i++) {
+            shooterX[i] += (stationX[i] - shooterX[i]) * 0.02f;
+            shooterY[i] += (stationY[i] - shooterY[i]) * 0.02f;
+
+            float dx = playerX + aimOffsetX[i] - shooterX[i];
+            float dy = playerY + aimOffsetY[i] - shooterY[i];
+            float scale = ENEMY_BULLET_VELOCITY / sqrtf(dx * dx + dy * dy + 1.0f);
+
+            aimX[i] = dx * scale;
+            aimY[i] = dy * scale;
+
+            // cooldown only ever gets to 0 by steps of 1, so adding the fire rate when it's ready resets it
+            int cooldown = shooterCooldown[i] - 1;
+            int ready = cooldown <= 0;
+            shooterReady[i] = ready;
+            shooterCooldown[i] = cooldown + ready * shooterFireRate[i];
+        }
+
+        // Collect who fires
+        numFiring = 0;
+        for (int i = base; i < end; i++) {
+            fireList[numFiring] = i;
+            numFiring += shooterReady[i];
+        }
+
+        fireBatch(numFiring);
+    }
+
+    shooterMs = (GetTime() - start) * 1000.0;
+
+    // Enemy bullets =====================================================
+    start = GetTime();
+
+    // Same trick as the shooters, an inactive bullet has 0 velocity so it can be moved anyway
+    liveEnemyBullets = 0;
+    for (int i = 0; i < MAX_ENEMY_BULLETS; i++) {
+        float x = enemyX[i] + enemyVX[i];
+        float y = enemyY[i] + enemyVY[i];
+        float inside = (x >= 0) & (x < screenWidth) & (y >= 0) & (y < screenHeight);
+        float active = enemyActive[i] * inside;
+
+        enemyX[i] = x;
+        enemyY[i] = y;
+        enemyVX[i] *= active;
+        enemyVY[i] *= active;
+        enemyActive[i] = active;
+        liveEnemyBullets += (int) active;
+    }
+
+    // How many are in the player's box (we just count them, no game over)
+    float left = player.rect.x;
+    float right = player.rect.x + player.rect.width;
+    float top = player.rect.y;
+    float bottom = player.rect.y + player.rect.height;
+
+    int hits = 0;
+
+    for (int i = 0; i < MAX_ENEMY_BULLETS; i++) {
+        float inside = (enemyX[i] >= left) * (enemyX[i] < right) * (enemyY[i] >= top) * (enemyY[i] < bottom);
+        float hit = enemyActive[i] * inside;
+
+        hits += (int) hit;
+        enemyActive[i] -= hit;
+        enemyVX[i] *= 1 - hit;
+        enemyVY[i] *= 1 - hit;
+    }
+
+    hitsTaken += hits;
+
+    enemyBulletMs = (GetTime() - start) * 1000.0;
+}
+
+/*
+Puts one bullet for every shooter in fireList into the pool.
+The slots are taken as one block from curEnemyBullet (the oldest bullets get overwritten if the pool is full, like curBullet
+in the other demos), so the writes are two straight runs at most.
+*/
+void fireBatch(int count) {
+    int written = 0;
+
+    while (written < count) {
+        int run = MAX_ENEMY_BULLETS - curEnemyBullet;
+        if (run > count - written) { run = count - written; }
+
+        for (int k = 0; k < run; k++) {
+            int s = fireList[written + k];
+            int b = curEnemyBullet + k;
+
+            enemyX[b] = shooterX[s];
+            enemyY[b] = shooterY[s];
+            enemyVX[b] = aimX[s];
+            enemyVY[b] = aimY[s];
+            enemyActive[b] = 1;
+        }
+
+        written += run;
+        curEnemyBullet += run;
+        if (curEnemyBullet >= MAX_ENEMY_BULLETS) { curEnemyBullet = 0; }
+    }
+
+    firedThisTick += count;
+}
+
+// Shooters come in from a random edge and settle somewhere on screen, each with its own fire rate and aim
+void spawnWave(int count) {
+    waveNumber++;
+
+    for (int n = 0; n < count && numShooters < MAX_SHOOTERS; n++) {
+        int i = numShooters++;
+
+        switch (GetRandomValue(0, 3)) {
+            case 0:
+                shooterX[i] = GetRandomValue(0, screenWidth);
+                shooterY[i] = -SHOOTER_SIZE;
+                break;
+            case 1:
+                shooterX[i] = GetRandomValue(0, screenWidth);
+                shooterY[i] = screenHeight + SHOOTER_SIZE;
+                break;
+            case 2:
+                shooterX[i] = -SHOOTER_SIZE;
+                shooterY[i] = GetRandomValue(0, screenHeight);
+                break;
+            default:
+                shooterX[i] = screenWidth + SHOOTER_SIZE;
+                shooterY[i] = GetRandomValue(0, screenHeight);
+        }
+
+        stationX[i] = GetRandomValue(20, screenWidth - 20);
+        stationY[i] = GetRandomValue(20, screenHeight - 20);
+        aimOffsetX[i] = GetRandomValue(-40, 40);
+        aimOffsetY[i] = GetRandomValue(-40, 40);
+        shooterFireRate[i] = GetRandomValue(60, 180);
+
+        // Random first shot so the wave doesn't fire all at once
+        shooterCooldown[i] = GetRandomValue(1, shooterFireRate[i]);
+        shooterReady[i] = 0;
+    }
+}
+
+// Last shooter moves into index, every field of it
+void removeShooter(int index) {
+    int last = --numShooters;
+
+    shooterX[index] = shooterX[last];
+    shooterY[index] = shooterY[last];
+    stationX[index] = stationX[last];
+    stationY[index] = stationY[last];
+    aimOffsetX[index] = aimOffsetX[last];
+    aimOffsetY[index] = aimOffsetY[last];
+    aimX[index] = aimX[last];
+    aimY[index] = aimY[last];
+    shooterCooldown[index] = shooterCooldown[last];
+    shooterFireRate[index] = shooterFireRate[last];
+    shooterReady[index] = shooterReady[last];
+}
+
+void getVelocities(int index) {
+    double deltaX = GetMouseX() - (player.rect.x + (player.rect.width / 2.0));
+    double deltaY = GetMouseY() - (player.rect.y + (player.rect.height / 2.0));
+
+    double ratio = BULLET_VELOCITY / sqrt(pow(deltaX, 2) + pow(deltaY, 2));
+
+    bullets[index].velocity.x = deltaX * ratio;
+    bullets[index].velocity.y = deltaY * ratio;
+}
+
+void draw() {
+    BeginDrawing();
+
+        ClearBackground(RAYWHITE);
+
+        for (int i = 0; i < MAX_ENEMY_BULLETS; i++) {
+            if (enemyActive[i] != 0) {
+                DrawRectangle(enemyX[i] - 1, enemyY[i] - 1, 3, 3, RED);
+            }
+        }
+
+        for (int i = 0; i < numShooters; i++) {
+            DrawRectangle(shooterX[i] - SHOOTER_SIZE / 2, shooterY[i] - SHOOTER_SIZE / 2, SHOOTER_SIZE, SHOOTER_SIZE, MAROON);
+        }
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                DrawRectangleRec(bullets[i].rect, bullets[i].color);
+            }
+        }
+
+        DrawRectangleRec(player.rect, player.color);
+
+        DrawRectangle(0, 0, 420, 160, Fade(RAYWHITE, 0.85f));
+        DrawText(TextFormat("wave %d: %d shooters (size %d [UP/DOWN])", waveNumber, numShooters, waveSize), 10, 10, 20, BLACK);
+        DrawText(TextFormat("enemy bullets: %d, fired %d this tick", liveEnemyBullets, firedThisTick), 10, 35, 20, BLACK);
+        DrawText(TextFormat("shooters: %.3f ms", shooterMs), 10, 60, 20, BLACK);
+        DrawText(TextFormat("enemy bullets: %.3f ms", enemyBulletMs), 10, 85, 20, BLACK);
+        DrawText(TextFormat("hits taken: %d, kills: %d", hitsTaken, kills), 10, 110, 20, BLACK);
+        DrawFPS(10, 135);
+
+    EndDrawing();
+}
@@ -0,0 +1,657 @@
+/*
+Morton Bullets - October 2026
+
+An updated version of "projectilePattern.c" with a lot more of everything: EMITTERS emitters, ~65k bullets and
+NUM_PROBES probes that each count the bullets around them every tick through a grid (the collision query part).
+
+Bullets are kept packed in bullets[0 .. numBullets), new ones go on the end and dead ones get the last one moved into
+their slot. So the order in memory is "when it was spawned / who got swapped where", and the bullets in one grid cell
+are all over the array. A probe reading the ~20 bullets in its cells then touches ~20 different cache lines.
+
+Every COMPACT_INTERVAL ticks we sort the whole array by the Z-order (Morton) code of the GRID_CELL cell each bullet is in.
+Interleaving the bits of the cell x and y means cells that are close on screen are mostly close in the order too, so after
+the sort one cell's bullets sit next to each other, and its neighbours' bullets are not far off.
+
+    sort: LSD radix sort, 8 bits a pass, SORT_THREADS threads. Each thread counts the digits in its own slice, the counts are
+          turned into where every thread writes each digit (thread 0's 3s go before thread 1's 3s, so it stays stable),
+          then every thread scatters its slice. The threads are started once in init() and meet at a barrier for every step,
+          so sortMs is the sort and not SORT_THREADS thread creates and joins 4 times a compaction
+    handles: anything outside the array (the bullets you clicked on) keeps a handle, not an index. handleIndex[] maps
+          handle -> index and is fixed up after every move, with a generation so a handle to a dead bullet stops working
+
+Cache misses for the probe pass are read from perf_event_open on Linux (the "misses" line shows n/a if that isn't allowed,
+eg. perf_event_paranoid or a container). The "line switches" number works everywhere: how often the probe pass reads a bullet
+on a different 64 byte line than the last bullet it read.
+
+Controls:
+    C               compaction on / off
+    K               compact now
+    left click      track the nearest bullet (its handle has to survive the compactions)
+    right click     stop tracking
+*/
+
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include "raylib.h"
+#include "raymath.h"
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+void init(void);
+void update(void);
+void draw(void);
+void spawnBullet(Vector2 position, Vector2 velocity);
+void removeBullet(int index);
+int handleToIndex(int handle);
+void buildGrid(void);
+void runProbes(void);
+void compact(void);
+void radixSort(int count);
+void runSortThreads(void *(*fn)(void *));
+void startSortWorkers(void);
+void stopSortWorkers(void);
+void *sortWorker(void *arg);
+void *histogramThread(void *arg);
+void *scatterThread(void *arg);
+unsigned int spreadBits(unsigned int v);
+unsigned int mortonCode(Vector2 position);
+void openMissCounter(void);
+void startMissCounter(void);
+long long stopMissCounter(void);
+
+#define SCREEN_WIDTH 1280
+#define SCREEN_HEIGHT 720
+
+#define MAX_BULLETS 131072
+#define EMITTERS 12
+#define SHOTS_PER_EMITTER 24
+#define BULLET_VELOCITY 2
+
+#define GRID_CELL 16
+#define GRID_WIDTH (SCREEN_WIDTH / GRID_CELL)
+#define GRID_HEIGHT (SCREEN_HEIGHT / GRID_CELL)
+#define NUM_PROBES 4096
+#define PROBE_RADIUS 12
+
+#define COMPACT_INTERVAL 60
+#define SORT_THREADS 4
+#define RADIX_BITS 8
+#define RADIX (1 << RADIX_BITS)
+
+// Handles are slot + generation << HANDLE_BITS, MAX_BULLETS has to fit in HANDLE_BITS
+#define HANDLE_BITS 17
+#define HANDLE_MASK ((1 << HANDLE_BITS) - 1)
+#define MAX_TRACKED 8
+
+#define CACHE_LINE 64
+
+typedef struct Bullet {
+    Vector2 position;
+    Vector2 velocity;
+    int handle;
+} Bullet;
+
+typedef struct SortJob {
+    int thread;
+    int begin;
+    int end;
+} SortJob;
+
+Bullet bullets[MAX_BULLETS];
+Bullet sorted[MAX_BULLETS];
+int numBullets = 0;
+
+// handle slot -> index into bullets (-1 when free), and the slot's current generation
+int handleIndex[MAX_BULLETS];
+int handleGen[MAX_BULLETS];
+int freeHandles[MAX_BULLETS];
+int numFreeHandles = 0;
+
+int tracked[MAX_TRACKED];
+int numTracked = 0;
+
+// Grid, the bullets in cell c are cellItems[cellStart[c]] to cellItems[cellStart[c + 1] - 1]
+int cellStart[GRID_WIDTH * GRID_HEIGHT + 1];
+int cellItems[MAX_BULLETS];
+
+Vector2 probes[NUM_PROBES];
+int probeHits[NUM_PROBES];
+
+// Radix sort, keys and bullet indices ping pong between [0] and [1]
+unsigned int sortKeys[2][MAX_BULLETS];
+int sortVals[2][MAX_BULLETS];
+int sortSrc = 0;
+int sortShift = 0;
+int histograms[SORT_THREADS][RADIX];
+SortJob sortJobs[SORT_THREADS];
+
+// Sort worker pool, sortJobs[0] (and the jobs of any worker that didn't start) run on the main thread
+pthread_t sortWorkers[SORT_THREADS];
+int numSortWorkers = 0;
+pthread_mutex_t sortStartLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_barrier_t sortStart;
+pthread_barrier_t sortDone;
+void *(*sortStep)(void *) = NULL;
+bool sortQuit = false;
+
+float emitterAngle = 0;
+int tick = 0;
+bool compaction = true;
+
+// Stats
+int missFd = -1;
+long long probeMisses = -1;
+long long lineSwitches = 0;
+long long missesBefore = -1;
+long long missesAfter = -1;
+long long switchesBefore = 0;
+long long switchesAfter = 0;
+bool justCompacted = false;
+double probeMs = 0;
+double sortMs = 0;
+int compactions = 0;
+
+int main() {
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    stopSortWorkers();
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    startSortWorkers();
+
+    // Every slot starts free, handed out from the bottom
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        handleIndex[i] = -1;
+        handleGen[i] = 0;
+        freeHandles[i] = MAX_BULLETS - 1 - i;
+    }
+    numFreeHandles = MAX_BULLETS;
+
+    for (int i = 0; i < NUM_PROBES; i++) {
+        probes[i] = (Vector2) {GetRandomValue(0, SCREEN_WIDTH - 1), GetRandomValue(0, SCREEN_HEIGHT - 1)};
+    }
+
+    openMissCounter();
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_C)) { compaction = !compaction; }
+
+    // Tracking ==========================================================
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && numTracked < MAX_TRACKED && numBullets > 0) {
+        Vector2 mouse = GetMousePosition();
+        int best = 0;
+        float bestDistSq = 1e30f;
+
+        for (int i = 0; i < numBullets; i++) {
+            float dx = bullets[i].position.x - mouse.x;
+            float dy = bullets[i].position.y - mouse.y;
+
+            if (dx * dx + dy * dy < bestDistSq) {
+                bestDistSq = dx * dx + dy * dy;
+                best = i;
+            }
+        }
+
+        tracked[numTracked++] = bullets[best].handle;
+    }
+    if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) { numTracked = 0; }
+
+    // Update bullets ====================================================
+    for (int i = 0; i < numBullets; i++) {
+        bullets[i].position.x += bullets[i].velocity.x;
+        bullets[i].position.y += bullets[i].velocity.y;
+
+        if (bullets[i].position.x < 0 || bullets[i].position.x >= SCREEN_WIDTH ||
+            bullets[i].position.y < 0 || bullets[i].position.y >= SCREEN_HEIGHT) {
+            removeBullet(i);
+            i--;
+        }
+    }
+
+    // Shoot =============================================================
+    for (int e = 0; e < EMITTERS; e++) {
+        Vector2 origin = (Vector2) {SCREEN_WIDTH * (e % 4 + 0.5f) / 4, SCREEN_HEIGHT * (e / 4 + 0.5f) / 3};
+        float turn = (e % 2 == 0) ? emitterAngle : -emitterAngle;
+
+        for (int s = 0; s < SHOTS_PER_EMITTER; s++) {
+            float angle = (turn + s * (360.0f / SHOTS_PER_EMITTER)) * DEG2RAD;
+            spawnBullet(origin, (Vector2) {cos(angle) * BULLET_VELOCITY, sin(angle) * BULLET_VELOCITY});
+        }
+    }
+
+    emitterAngle += 3.7f;
+    tick++;
+
+    // Compaction ========================================================
+    if ((compaction && tick % COMPACT_INTERVAL == 0) || IsKeyPressed(KEY_K)) {
+        double start = GetTime();
+        compact();
+        sortMs = (GetTime() - start) * 1000.0;
+        compactions++;
+
+        // The probe pass before this was the worst case, the one right after is the best
+        missesBefore = probeMisses;
+        switchesBefore = lineSwitches;
+        justCompacted = true;
+    }
+
+    // Probes ============================================================
+    for (int i = 0; i < NUM_PROBES; i++) {
+        probes[i].x += GetRandomValue(-1, 1);
+        probes[i].y += GetRandomValue(-1, 1);
+        probes[i].x = Clamp(probes[i].x, 0, SCREEN_WIDTH - 1);
+        probes[i].y = Clamp(probes[i].y, 0, SCREEN_HEIGHT - 1);
+    }
+
+    buildGrid();
+
+    double start = GetTime();
+    startMissCounter();
+    runProbes();
+    probeMisses = stopMissCounter();
+    probeMs = (GetTime() - start) * 1000.0;
+
+    if (justCompacted) {
+        missesAfter = probeMisses;
+        switchesAfter = lineSwitches;
+        justCompacted = false;
+    }
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        for (int i = 0; i < numBullets; i++) {
+            DrawRectangle(bullets[i].position.x, bullets[i].position.y, 2, 2, SKYBLUE);
+        }
+
+        for (int i = 0; i < NUM_PROBES; i++) {
+            if (probeHits[i] > 0) {
+                DrawRectangle(probes[i].x - 1, probes[i].y - 1, 3, 3, RED);
+            }
+        }
+
+        for (int t = 0; t < numTracked; t++) {
+            int index = handleToIndex(tracked[t]);
+
+            if (index >= 0) {
+                DrawCircleLines(bullets[index].position.x, bullets[index].position.y, 8, YELLOW);
+            }
+        }
+
+        DrawRectangle(5, 5, 520, 180, Fade(BLACK, 0.7f));
+        DrawText(TextFormat("%d bullets, compaction %s [C], %d done", numBullets, compaction ? "on" : "off", compactions), 10, 10, 20, WHITE);
+        DrawText(TextFormat("probes: %.3f ms, sort: %.3f ms", probeMs, sortMs), 10, 35, 20, WHITE);
+
+        if (probeMisses >= 0) {
+            DrawText(TextFormat("misses: %lld (last compaction %lld -> %lld)", probeMisses, missesBefore, missesAfter), 10, 60, 20, WHITE);
+        }
+        else {
+            DrawText("misses: n/a (no perf counters)", 10, 60, 20, GRAY);
+        }
+
+        DrawText(TextFormat("line switches: %lld (last compaction %lld -> %lld)", lineSwitches, switchesBefore, switchesAfter), 10, 85, 20, WHITE);
+        DrawText(TextFormat("reduction: %.0f%%", (switchesBefore > 0) ? 100.0 * (switchesBefore - switchesAfter) / switchesBefore : 0.0), 10, 110, 20, WHITE);
+        DrawText(TextFormat("tracking %d [click]", numTracked), 10, 135, 20, YELLOW);
+        DrawFPS(10, 160);
+
+    EndDrawing();
+}
+
+void spawnBullet(Vector2 position, Vector2 velocity) {
+    if (numBullets >= MAX_BULLETS || numFreeHandles == 0) {
+        return;
+    }
+
+    int slot = freeHandles[--numFreeHandles];
+
+    bullets[numBullets].position = position;
+    bullets[numBullets].velocity = velocity;
+    bullets[numBullets].handle = slot | (handleGen[slot] << HANDLE_BITS);
+    handleIndex[slot] = numBullets;
+
+    numBullets++;
+}
+
+// Moves the last bullet into index, and bumps the dead one's generation so old handles to it stop working
+void removeBullet(int index) {
+    int slot = bullets[index].handle & HANDLE_MASK;
+
+    handleIndex[slot] = -1;
+    handleGen[slot] = (handleGen[slot] + 1) & 0x3FFF;
+    freeHandles[numFreeHandles++] = slot;
+
+    numBullets--;
+    if (index != numBullets) {
+        bullets[index] = bullets[numBullets];
+        handleIndex[bullets[index].handle & HANDLE_MASK] = index;
+    }
+}
+
+// -1 if the bullet is gone
+int handleToIndex(int handle) {
+    int slot = handle & HANDLE_MASK;
+
+    if (handleGen[slot] != (handle >> HANDLE_BITS) || handleIndex[slot] < 0) {
+        return -1;
+    }
+
+    return handleIndex[slot];
+}
+
+// Counting sort of bullet indices by cell, so cellItems is in bullets[] order inside every cell
+void buildGrid(void) {
+    static int fill[GRID_WIDTH * GRID_HEIGHT];
+
+    memset(cellStart, 0, sizeof(cellStart));
+
+    for (int i = 0; i < numBullets; i++) {
+        int cell = ((int) bullets[i].position.y / GRID_CELL) * GRID_WIDTH + ((int) bullets[i].position.x / GRID_CELL);
+        cellStart[cell + 1]++;
+    }
+
+    for (int c = 0; c < GRID_WIDTH * GRID_HEIGHT; c++) {
+        cellStart[c + 1] += cellStart[c];
+        fill[c] = cellStart[c];
+    }
+
+    for (int i = 0; i < numBullets; i++) {
+        int cell = ((int) bullets[i].position.y / GRID_CELL) * GRID_WIDTH + ((int) bullets[i].position.x / GRID_CELL);
+        cellItems[fill[cell]++] = i;
+    }
+}
+
+// Every probe counts the bullets within PROBE_RADIUS, looking in the 2 x 2 cells that can hold them
+void runProbes(void) {
+    long lastLine = -1;
+    lineSwitches = 0;
+
+    for (int p = 0; p < NUM_PROBES; p++) {
+        int x0 = (int) (probes[p].x - PROBE_RADIUS) / GRID_CELL;
+        int y0 = (int) (probes[p].y - PROBE_RADIUS) / GRID_CELL;
+        int x1 = (int) (probes[p].x + PROBE_RADIUS) / GRID_CELL;
+        int y1 = (int) (probes[p].y + PROBE_RADIUS) / GRID_CELL;
+
+        if (probes[p].x < PROBE_RADIUS) { x0 = 0; }
+        if (probes[p].y < PROBE_RADIUS) { y0 = 0; }
+        if (x1 >= GRID_WIDTH) { x1 = GRID_WIDTH - 1; }
+        if (y1 >= GRID_HEIGHT) { y1 = GRID_HEIGHT - 1; }
+
+        int hits = 0;
+
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                int cell = y * GRID_WIDTH + x;
+
+                for (int e = cellStart[cell]; e < cellStart[cell + 1]; e++) {
+                    int i = cellItems[e];
+                    long line = (long) i * sizeof(Bullet) / CACHE_LINE;
+
+                    if (line != lastLine) {
+                        lineSwitches++;
+                        lastLine = line;
+                    }
+
+                    float dx = bullets[i].position.x - probes[p].x;
+                    float dy = bullets[i].position.y - probes[p].y;
+
+                    if (dx * dx + dy * dy < PROBE_RADIUS * PROBE_RADIUS) {
+                        hits++;
+                    }
+                }
+            }
+        }
+
+        probeHits[p] = hits;
+    }
+}
+
+// Sort by Morton code, move the bullets into that order, then point every handle at its bullet's new index
+void compact(void) {
+    for (int i = 0; i < numBullets; i++) {
+        sortKeys[0][i] = mortonCode(bullets[i].position);
+        sortVals[0][i] = i;
+    }
+
+    radixSort(numBullets);
+
+    for (int i = 0; i < numBullets; i++) {
+        sorted[i] = bullets[sortVals[sortSrc][i]];
+        handleIndex[sorted[i].handle & HANDLE_MASK] = i;
+    }
+
+    memcpy(bullets, sorted, numBullets * sizeof(Bullet));
+}
+
+// Cell x and y are under 256, so the code fits in 16 bits and two 8 bit passes sort it
+void radixSort(int count) {
+    sortSrc = 0;
+
+    for (int t = 0; t < SORT_THREADS; t++) {
+        sortJobs[t] = (SortJob) {t, count * t / SORT_THREADS, count * (t + 1) / SORT_THREADS};
+    }
+
+    for (sortShift = 0; sortShift < 16; sortShift += RADIX_BITS) {
+        runSortThreads(histogramThread);
+
+        // Digit d from thread t goes after every smaller digit, and after digit d from every earlier thread
+        int offset = 0;
+        for (int d = 0; d < RADIX; d++) {
+            for (int t = 0; t < SORT_THREADS; t++) {
+                int n = histograms[t][d];
+                histograms[t][d] = offset;
+                offset += n;
+            }
+        }
+
+        runSortThreads(scatterThread);
+        sortSrc = 1 - sortSrc;
+    }
+}
+
+// Runs fn on every sortJob, jobs 1 .. numSortWorkers on the pool and the rest right here
+void runSortThreads(void *(*fn)(void *)) {
+    sortStep = fn;
+
+    if (numSortWorkers > 0) {
+        pthread_barrier_wait(&sortStart);
+    }
+
+    fn(&sortJobs[0]);
+    for (int t = numSortWorkers + 1; t < SORT_THREADS; t++) {
+        fn(&sortJobs[t]);
+    }
+
+    if (numSortWorkers > 0) {
+        pthread_barrier_wait(&sortDone);
+    }
+}
+
+/*
+Same as the spawn pool in parallelSpawn.c: the barriers need to know how many threads meet at them, so the workers wait on
+sortStartLock until every pthread_create() has come back. A worker that can't be started just has its job run inline.
+*/
+void startSortWorkers(void) {
+    pthread_mutex_lock(&sortStartLock);
+
+    numSortWorkers = 0;
+    for (int t = 1; t < SORT_THREADS; t++) {
+        if (pthread_create(&sortWorkers[numSortWorkers], NULL, sortWorker, &sortJobs[t]) != 0) {
+            TraceLog(LOG_WARNING, "SORT: could not start sort thread %d, its part of the sort runs on the main thread", t);
+            break;
+        }
+        numSortWorkers++;
+    }
+
+    if (numSortWorkers > 0) {
+        pthread_barrier_init(&sortStart, NULL, numSortWorkers + 1);
+        pthread_barrier_init(&sortDone, NULL, numSortWorkers + 1);
+    }
+
+    pthread_mutex_unlock(&sortStartLock);
+}
+
+void stopSortWorkers(void) {
+    if (numSortWorkers == 0) {
+        return;
+    }
+
+    sortQuit = true;
+    pthread_barrier_wait(&sortStart);
+
+    for (int t = 0; t < numSortWorkers; t++) {
+        pthread_join(sortWorkers[t], NULL);
+    }
+
+    pthread_barrier_destroy(&sortStart);
+    pthread_barrier_destroy(&sortDone);
+    numSortWorkers = 0;
+    sortQuit = false;
+}
+
+// A pool thread: every time the main thread gets to sortStart, run sortStep on our job
+void *sortWorker(void *arg) {
+    SortJob *job = arg;
+
+    pthread_mutex_lock(&sortStartLock);
+    pthread_mutex_unlock(&sortStartLock);
+
+    while (true) {
+        pthread_barrier_wait(&sortStart);
+
+        if (sortQuit) {
+            break;
+        }
+
+        sortStep(job);
+
+        pthread_barrier_wait(&sortDone);
+    }
+
+    return NULL;
+}
+
+void *histogramThread(void *arg) {
+    SortJob *job = arg;
+    int *histogram = histograms[job->thread];
+
+    memset(histogram, 0, RADIX * sizeof(int));
+
+    for (int i = job->begin; i < job->end; i++) {
+        histogram[(sortKeys[sortSrc][i] >> sortShift) & (RADIX - 1)]++;
+    }
+
+    return NULL;
+}
+
+// histograms[] holds write positions by now
+void *scatterThread(void *arg) {
+    SortJob *job = arg;
+    int *offsets = histograms[job->thread];
+    int dst = 1 - sortSrc;
+
+    for (int i = job->begin; i < job->end; i++) {
+        unsigned int key = sortKeys[sortSrc][i];
+        int pos = offsets[(key >> sortShift) & (RADIX - 1)]++;
+
+        sortKeys[dst][pos] = key;
+        sortVals[dst][pos] = sortVals[sortSrc][i];
+    }
+
+    return NULL;
+}
+
+// Spreads the low 8 bits of v out to the even bits, eg. 1011 -> 1000101
+unsigned int spreadBits(unsigned int v) {
+    v &= 0xFF;
+    v = (v | (v << 4)) & 0x0F0F;
+    v = (v | (v << 2)) & 0x3333;
+    v = (v | (v << 1)) & 0x5555;
+
+    return v;
+}
+
+unsigned int mortonCode(Vector2 position) {
+    unsigned int x = (unsigned int) position.x / GRID_CELL;
+    unsigned int y = (unsigned int) position.y / GRID_CELL;
+
+    return spreadBits(x) | (spreadBits(y) << 1);
+}
+
+// Cache miss counter ====================================================
+
+#if defined(__linux__)
+
+void openMissCounter(void) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // This thread, any cpu. Fails (and we just show n/a) if perf isn't allowed here
+    missFd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+    if (missFd < 0) {
+        TraceLog(LOG_WARNING, "MORTON: perf_event_open failed, no cache miss numbers");
+    }
+}
+
+void startMissCounter(void) {
+    if (missFd >= 0) {
+        ioctl(missFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(missFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+long long stopMissCounter(void) {
+    long long count = -1;
+
+    if (missFd >= 0) {
+        ioctl(missFd, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (read(missFd, &count, sizeof(count)) != sizeof(count)) {
+            count = -1;
+        }
+    }
+
+    return count;
+}
+
+#else
+
+void openMissCounter(void) {}
+void startMissCounter(void) {}
+long long stopMissCounter(void) { return -1; }
+
+#endif
@@ -0,0 +1,584 @@
+/*
+Parallel Spawn - October 2026
+
+An updated version of "borderOfWaveAndParticle.c" with a lot of emitters, evaluated on SPAWN_THREADS threads at once.
+
+Every other demo spawns with bullets[curBullet] = ...; curBullet++; which is fine on one thread, but once emitters run in
+parallel every thread wants that cursor. This has four ways of getting the shots into the pool, M cycles through them:
+    locked      one mutex around the old curBullet code, taken for every shot
+    atomic      a shared atomic cursor, bumped for every shot
+    batch       every thread evaluates EMITTER_BATCH emitters into a local array, reserves room for all of their shots in the
+                spawn queue with one atomic add, and copies them in
+    staging     every thread appends to its own staging buffer, nothing is shared at all
+The first two write straight into the pool, in whatever order the threads got there, so the pool comes out different
+every run. The last two only fill the spawn queue while the threads run, and the queue is merged into the pool on the main
+thread once they are all done, in emitter order (batch by batch, or thread by thread, since every thread has a fixed
+run of emitters). So those two give exactly the same pool as running everything on one thread.
+
+The contention counter: for the atomic adds it's how often the cursor had already moved between a plain load just before
+the add and the add itself (another thread's add got in between), for the mutex it's how often trylock found it already
+taken.
+
+The spawn threads are started once and kept, every tick the main thread hands out the emitters, meets them at a barrier,
+runs the first run of emitters itself and waits at a second barrier for the rest, so a tick doesn't pay for creating
+and joining threads.
+
+Stress test, no window: parallelSpawn --stress [ticks] [threads]
+runs every mode with STRESS_EMITTERS emitters all firing every tick, and prints the time, the contention and whether the
+pool matches the one thread result.
+
+Controls:
+    M           spawn mode
+    T           threads (1 .. SPAWN_THREADS)
+    UP / DOWN   number of emitters
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+void tickWorld(void);
+void startWorkers(void);
+void stopWorkers(void);
+void *spawnWorker(void *arg);
+void runSpawnJob(int thread);
+int evalEmitter(int emitter, int now, Vector2 *out);
+void poolPush(Vector2 position, Vector2 velocity);
+void mergeSpawns(void);
+unsigned int reserve(atomic_uint *cursor, unsigned int count, long *contended);
+void resetWorld(void);
+uint64_t hashPool(void);
+void runStress(int ticks, int threads);
+double wallTime(void);
+
+#define SCREEN_WIDTH 1280
+#define SCREEN_HEIGHT 720
+
+// Power of 2, so the atomic cursor can just wrap
+#define MAX_BULLETS (1 << 18)
+#define MAX_EMITTERS 8192
+#define SHOTS_PER_FIRE 5
+#define MAX_SPAWNS (MAX_EMITTERS * SHOTS_PER_FIRE)
+#define BULLET_VELOCITY 3
+#define FIRE_INTERVAL 4
+
+#define SPAWN_THREADS 8
+#define EMITTER_BATCH 64
+#define NUM_BATCHES ((MAX_EMITTERS + EMITTER_BATCH - 1) / EMITTER_BATCH)
+
+#define STRESS_EMITTERS 8192
+#define STRESS_TICKS 300
+
+enum { SPAWN_LOCKED, SPAWN_ATOMIC, SPAWN_BATCH, SPAWN_STAGING, NUM_SPAWN_MODES };
+const char *spawnModeNames[NUM_SPAWN_MODES] = {"locked", "atomic", "batch", "staging"};
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+} Spawn;
+
+// One per thread, each on its own cache lines so the counters don't bounce between cores
+typedef struct {
+    int thread;
+    int firstEmitter;
+    int lastEmitter;
+    long spawned;
+    long contended;
+    Spawn *staging;
+    int numStaged;
+    char pad[64];
+} SpawnJob;
+
+Bullet bullets[MAX_BULLETS];
+int curBullet = 0;
+
+// Shared by the threads, depending on the mode
+pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+atomic_uint poolCursor;
+atomic_uint queueCursor;
+Spawn spawnQueue[MAX_SPAWNS];
+int batchStart[NUM_BATCHES];
+int batchCount[NUM_BATCHES];
+
+SpawnJob jobs[SPAWN_THREADS];
+
+// The worker pool, jobs[0] is always run by the main thread so there are at most SPAWN_THREADS - 1 of these
+pthread_t workers[SPAWN_THREADS];
+int numWorkers = 0;
+pthread_mutex_t workerStartLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_barrier_t tickStart;
+pthread_barrier_t tickDone;
+bool workersQuit = false;
+
+int spawnMode = SPAWN_BATCH;
+int numThreads = 4;
+int numEmitters = 512;
+int fireInterval = FIRE_INTERVAL;
+int tick = 0;
+
+// Last tick
+int spawnedThisTick = 0;
+long contendedThisTick = 0;
+double spawnMs = 0;
+double mergeMs = 0;
+
+int main(int argc, char **argv) {
+
+    if (argc > 1 && strcmp(argv[1], "--stress") == 0) {
+        int ticks = (argc > 2) ? atoi(argv[2]) : STRESS_TICKS;
+        int threads = (argc > 3) ? atoi(argv[3]) : SPAWN_THREADS;
+
+        startWorkers();
+        runStress(ticks, threads);
+        stopWorkers();
+        return 0;
+    }
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    stopWorkers();
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    startWorkers();
+    resetWorld();
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_M)) { spawnMode = (spawnMode + 1) % NUM_SPAWN_MODES; }
+    if (IsKeyPressed(KEY_T)) { numThreads = (numThreads % (numWorkers + 1)) + 1; }
+    if (IsKeyPressed(KEY_UP)) { numEmitters *= 2; }
+    if (IsKeyPressed(KEY_DOWN)) { numEmitters /= 2; }
+    if (numEmitters < 1) { numEmitters = 1; }
+    if (numEmitters > MAX_EMITTERS) { numEmitters = MAX_EMITTERS; }
+
+    tickWorld();
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        // Tens of thousands of them, so small squares instead of circles
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                DrawRectangle(bullets[i].position.x - 1, bullets[i].position.y - 1, 3, 3, PURPLE);
+            }
+        }
+
+        DrawRectangle(5, 5, 480, 130, Fade(BLACK, 0.7f));
+        DrawText(TextFormat("mode %s [M], %d threads [T], %d emitters", spawnModeNames[spawnMode], numThreads, numEmitters), 10, 10, 20, WHITE);
+        DrawText(TextFormat("spawned %d, contention %ld", spawnedThisTick, contendedThisTick), 10, 35, 20, WHITE);
+        DrawText(TextFormat("spawn %.3f ms, merge %.3f ms", spawnMs, mergeMs), 10, 60, 20, WHITE);
+        DrawText(TextFormat("pool cursor %d / %d", curBullet, MAX_BULLETS), 10, 85, 20, WHITE);
+        DrawFPS(10, 110);
+
+    EndDrawing();
+}
+
+/*
+One tick: move the bullets (on this thread, that's not what this is about), then run the emitters on numThreads threads
+(this one and numThreads - 1 workers), then merge whatever they queued. Nothing gets into the pool after the merge, so the
+rest of the tick sees a finished pool.
+*/
+void tickWorld(void) {
+    tick++;
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!bullets[i].isActive) {
+            continue;
+        }
+
+        bullets[i].position.x += bullets[i].velocity.x;
+        bullets[i].position.y += bullets[i].velocity.y;
+
+        if (bullets[i].position.x < 0 || bullets[i].position.x >= SCREEN_WIDTH ||
+            bullets[i].position.y < 0 || bullets[i].position.y >= SCREEN_HEIGHT) {
+            bullets[i].isActive = false;
+        }
+    }
+
+    double start = wallTime();
+
+    atomic_store(&poolCursor, curBullet);
+    atomic_store(&queueCursor, 0);
+
+    // Every thread gets a run of whole batches, so no batch is ever split between two threads
+    // Workers past numThreads get an empty run, they still go through both barriers but don't touch anything
+    int numBatches = (numEmitters + EMITTER_BATCH - 1) / EMITTER_BATCH;
+
+    for (int t = 0; t <= numWorkers; t++) {
+        jobs[t].thread = t;
+        jobs[t].firstEmitter = 0;
+        jobs[t].lastEmitter = 0;
+        if (t < numThreads) {
+            jobs[t].firstEmitter = (numBatches * t / numThreads) * EMITTER_BATCH;
+            jobs[t].lastEmitter = (numBatches * (t + 1) / numThreads) * EMITTER_BATCH;
+            if (jobs[t].lastEmitter > numEmitters) { jobs[t].lastEmitter = numEmitters; }
+        }
+        jobs[t].spawned = 0;
+        jobs[t].contended = 0;
+        jobs[t].numStaged = 0;
+    }
+
+    if (numWorkers > 0) {
+        pthread_barrier_wait(&tickStart);
+    }
+
+    runSpawnJob(0);
+
+    if (numWorkers > 0) {
+        pthread_barrier_wait(&tickDone);
+    }
+
+    spawnedThisTick = 0;
+    contendedThisTick = 0;
+
+    for (int t = 0; t <= numWorkers; t++) {
+        spawnedThisTick += jobs[t].spawned;
+        contendedThisTick += jobs[t].contended;
+    }
+
+    spawnMs = (wallTime() - start) * 1000.0;
+
+    start = wallTime();
+    mergeSpawns();
+    mergeMs = (wallTime() - start) * 1000.0;
+}
+
+/*
+Starts up to SPAWN_THREADS - 1 workers. The barriers need to know how many threads meet at them, and that's only known once
+every pthread_create() has come back, so the workers wait on workerStartLock until the barriers are set up.
+If some of them can't be started we just run with fewer threads.
+*/
+void startWorkers(void) {
+    pthread_mutex_lock(&workerStartLock);
+
+    numWorkers = 0;
+    for (int t = 1; t < SPAWN_THREADS; t++) {
+        if (pthread_create(&workers[numWorkers], NULL, spawnWorker, &jobs[t]) != 0) {
+            TraceLog(LOG_WARNING, "SPAWN: could not start spawn thread %d, running with %d", t, numWorkers + 1);
+            break;
+        }
+        numWorkers++;
+    }
+
+    if (numWorkers > 0) {
+        pthread_barrier_init(&tickStart, NULL, numWorkers + 1);
+        pthread_barrier_init(&tickDone, NULL, numWorkers + 1);
+    }
+
+    if (numThreads > numWorkers + 1) { numThreads = numWorkers + 1; }
+
+    pthread_mutex_unlock(&workerStartLock);
+}
+
+void stopWorkers(void) {
+    if (numWorkers == 0) {
+        return;
+    }
+
+    // The barrier is the sync for workersQuit like it is for the jobs, so it doesn't need to be atomic
+    workersQuit = true;
+    pthread_barrier_wait(&tickStart);
+
+    for (int t = 0; t < numWorkers; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    pthread_barrier_destroy(&tickStart);
+    pthread_barrier_destroy(&tickDone);
+    numWorkers = 0;
+    workersQuit = false;
+}
+
+// A pool thread: wait for the main thread to hand out a tick, run our job, say we're done, until stopWorkers()
+void *spawnWorker(void *arg) {
+    int thread = (SpawnJob *) arg - jobs;
+
+    pthread_mutex_lock(&workerStartLock);
+    pthread_mutex_unlock(&workerStartLock);
+
+    while (true) {
+        pthread_barrier_wait(&tickStart);
+
+        if (workersQuit) {
+            break;
+        }
+
+        runSpawnJob(thread);
+
+        pthread_barrier_wait(&tickDone);
+    }
+
+    return NULL;
+}
+
+void runSpawnJob(int thread) {
+    SpawnJob *job = &jobs[thread];
+    Spawn local[EMITTER_BATCH * SHOTS_PER_FIRE];
+    Vector2 shots[SHOTS_PER_FIRE * 2];
+
+    for (int e = job->firstEmitter; e < job->lastEmitter; ) {
+        int batch = e / EMITTER_BATCH;
+        int batchEnd = (batch + 1) * EMITTER_BATCH;
+        if (batchEnd > job->lastEmitter) { batchEnd = job->lastEmitter; }
+
+        int numLocal = 0;
+
+        for (; e < batchEnd; e++) {
+            int count = evalEmitter(e, tick, shots);
+
+            for (int s = 0; s < count; s++) {
+                Vector2 position = shots[s * 2];
+                Vector2 velocity = shots[s * 2 + 1];
+
+                switch (spawnMode) {
+                    case SPAWN_LOCKED:
+                        if (pthread_mutex_trylock(&poolLock) != 0) {
+                            job->contended++;
+                            pthread_mutex_lock(&poolLock);
+                        }
+                        poolPush(position, velocity);
+                        pthread_mutex_unlock(&poolLock);
+                        break;
+
+                    case SPAWN_ATOMIC: {
+                        unsigned int slot = reserve(&poolCursor, 1, &job->contended) & (MAX_BULLETS - 1);
+                        bullets[slot] = (Bullet) {position, velocity, true};
+                        break;
+                    }
+
+                    case SPAWN_BATCH:
+                        local[numLocal++] = (Spawn) {position, velocity};
+                        break;
+
+                    case SPAWN_STAGING:
+                        job->staging[job->numStaged++] = (Spawn) {position, velocity};
+                        break;
+                }
+
+                job->spawned++;
+            }
+        }
+
+        // One reservation for the whole batch, and where it landed is kept so the merge can put batches back in order
+        if (spawnMode == SPAWN_BATCH) {
+            unsigned int start = reserve(&queueCursor, numLocal, &job->contended);
+            memcpy(&spawnQueue[start], local, numLocal * sizeof(Spawn));
+
+            batchStart[batch] = start;
+            batchCount[batch] = numLocal;
+        }
+    }
+}
+
+/*
+Emitter number emitter at tick now, the shots go into out as position, velocity pairs.
+Only depends on emitter and now, so it doesn't matter which thread runs it or when.
+Emitters sit on a sunflower spiral around the middle, and each one spins its ring of SHOTS_PER_FIRE shots its own way.
+*/
+int evalEmitter(int emitter, int now, Vector2 *out) {
+    if ((now + emitter) % fireInterval != 0) {
+        return 0;
+    }
+
+    float radius = 330.0f * sqrtf((emitter + 0.5f) / MAX_EMITTERS);
+    float theta = emitter * 2.39996f;
+    Vector2 centre = {SCREEN_WIDTH / 2 + radius * cosf(theta), SCREEN_HEIGHT / 2 + radius * sinf(theta)};
+
+    float spin = ((emitter % 2 == 0) ? 1 : -1) * (0.01f + 0.0001f * (emitter % 97));
+    float rotation = theta + spin * now;
+
+    for (int s = 0; s < SHOTS_PER_FIRE; s++) {
+        float angle = rotation + s * (2 * PI / SHOTS_PER_FIRE);
+
+        out[s * 2] = centre;
+        out[s * 2 + 1] = (Vector2) {cosf(angle) * BULLET_VELOCITY, sinf(angle) * BULLET_VELOCITY};
+    }
+
+    return SHOTS_PER_FIRE;
+}
+
+// The old way, only ever called on one thread at a time (the main thread, or with poolLock held)
+void poolPush(Vector2 position, Vector2 velocity) {
+    bullets[curBullet] = (Bullet) {position, velocity, true};
+
+    curBullet++;
+    if (curBullet >= MAX_BULLETS) {
+        curBullet = 0;
+    }
+}
+
+// The one place the queued shots go into the pool, always in emitter order
+void mergeSpawns(void) {
+    switch (spawnMode) {
+        case SPAWN_LOCKED:
+            // Already in the pool
+            break;
+
+        case SPAWN_ATOMIC:
+            curBullet = atomic_load(&poolCursor) & (MAX_BULLETS - 1);
+            break;
+
+        case SPAWN_BATCH: {
+            int numBatches = (numEmitters + EMITTER_BATCH - 1) / EMITTER_BATCH;
+
+            for (int b = 0; b < numBatches; b++) {
+                for (int i = 0; i < batchCount[b]; i++) {
+                    poolPush(spawnQueue[batchStart[b] + i].position, spawnQueue[batchStart[b] + i].velocity);
+                }
+            }
+            break;
+        }
+
+        case SPAWN_STAGING:
+            for (int t = 0; t < numThreads; t++) {
+                for (int i = 0; i < jobs[t].numStaged; i++) {
+                    poolPush(jobs[t].staging[i].position, jobs[t].staging[i].velocity);
+                }
+            }
+            break;
+    }
+}
+
+/*
+One atomic add, so it never loops however busy the cursor is.
+The load just before it is only for the counter: if the add didn't start where the load saw the cursor, another thread's
+add landed in between. That misses adds that land between two of our own loads, so it's a lower bound, but it costs no
+extra write to the cursor's cache line.
+*/
+unsigned int reserve(atomic_uint *cursor, unsigned int count, long *contended) {
+    unsigned int seen = atomic_load_explicit(cursor, memory_order_relaxed);
+
+    // relaxed is enough, the tickDone barrier before anyone reads what was written is the sync
+    unsigned int start = atomic_fetch_add_explicit(cursor, count, memory_order_relaxed);
+
+    if (start != seen) {
+        (*contended)++;
+    }
+
+    return start;
+}
+
+void resetWorld(void) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        bullets[i].isActive = false;
+    }
+
+    for (int t = 0; t < SPAWN_THREADS; t++) {
+        if (jobs[t].staging == NULL) {
+            jobs[t].staging = malloc(MAX_SPAWNS * sizeof(Spawn));
+        }
+    }
+
+    curBullet = 0;
+    tick = 0;
+}
+
+// FNV-1a over every active bullet and where it is in the pool
+uint64_t hashPool(void) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!bullets[i].isActive) {
+            continue;
+        }
+
+        uint32_t words[3];
+        words[0] = i;
+        memcpy(&words[1], &bullets[i].position.x, sizeof(float));
+        memcpy(&words[2], &bullets[i].position.y, sizeof(float));
+
+        for (int w = 0; w < 3; w++) {
+            hash = (hash ^ words[w]) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+/*
+Every mode with threads threads, then staging on 1 thread as the answer to check against.
+Every emitter fires every tick, so this is STRESS_EMITTERS * SHOTS_PER_FIRE shots a tick, all from the spawn threads.
+*/
+void runStress(int ticks, int threads) {
+    if (threads < 1) { threads = 1; }
+    if (threads > numWorkers + 1) { threads = numWorkers + 1; }
+
+    numEmitters = STRESS_EMITTERS;
+    fireInterval = 1;
+
+    resetWorld();
+    spawnMode = SPAWN_STAGING;
+    numThreads = 1;
+    for (int t = 0; t < ticks; t++) {
+        tickWorld();
+    }
+    uint64_t reference = hashPool();
+
+    printf("%d emitters, %d shots a tick, %d ticks, %d threads\n\n", numEmitters, numEmitters * SHOTS_PER_FIRE, ticks, threads);
+    printf("%-8s  %10s  %10s  %12s  %14s  %s\n", "mode", "spawn ms", "merge ms", "Mspawns / s", "contention", "same pool as 1 thread");
+
+    for (int mode = 0; mode < NUM_SPAWN_MODES; mode++) {
+        resetWorld();
+        spawnMode = mode;
+        numThreads = threads;
+
+        double spawnTotal = 0;
+        double mergeTotal = 0;
+        long spawnedTotal = 0;
+        long contendedTotal = 0;
+
+        for (int t = 0; t < ticks; t++) {
+            tickWorld();
+
+            spawnTotal += spawnMs;
+            mergeTotal += mergeMs;
+            spawnedTotal += spawnedThisTick;
+            contendedTotal += contendedThisTick;
+        }
+
+        printf("%-8s  %10.3f  %10.3f  %12.1f  %14ld  %s\n", spawnModeNames[mode], spawnTotal / ticks, mergeTotal / ticks,
+               spawnedTotal / ((spawnTotal + mergeTotal) * 1000.0), contendedTotal,
+               (hashPool() == reference) ? "yes" : "no");
+    }
+}
+
+double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + (now.tv_nsec / 1000000000.0);
+}
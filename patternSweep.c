@@ -0,0 +1,392 @@
+/*
+Pattern Sweep - October 2026
+
+A headless version of "projectilePattern.c" for finding good patterns without pressing A/D/UP/DOWN one run at a time.
+It runs the same orbiter and emitter for every combination of starting angleChange, angleChange acceleration
+(the += 0.025 in projectilePattern.c) and shootRate, spread across every core, then ranks them.
+
+Each run is an Instance with its own bullets and its own copies of what were globals in projectilePattern.c,
+so the threads never share anything except the next-job counter.
+
+RADIUS is not swept: bullets leave from the centre towards the orbiter, so the radius only moves the yellow dot,
+the pattern is the same.
+
+Per run we measure, over the second half of the run (the first half is warm-up):
+    coverage    fraction of the COVER_CELL sized cells on screen that a bullet passed through
+    evenness    1 / (1 + variance / mean^2) of how many bullet-frames each cell got, 1 is perfectly even
+    period      smallest number of shots after which the shot directions repeat, 0 if they never do
+    score       coverage * evenness
+
+Output:
+    sweep_results.csv           every run, best first
+    sweep_<rank>.png            thumbnails of the best THUMBNAIL_COUNT runs (the last THUMBNAIL_TRAIL frames overlaid)
+
+Usage: patternSweep [frames] [threads]
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "raylib.h"
+
+typedef struct Bullet {
+    float centreX;
+    float centreY;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+#define MAX_BULLETS 500
+#define BULLET_VELOCITY 5
+
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 450
+
+#define COVER_CELL 20
+#define COVER_WIDTH (SCREEN_WIDTH / COVER_CELL)
+#define COVER_HEIGHT (SCREEN_HEIGHT / COVER_CELL)
+
+#define MAX_PERIOD 720
+#define PERIOD_TOLERANCE 0.5
+
+#define THUMBNAIL_COUNT 16
+#define THUMBNAIL_SCALE 4
+#define THUMBNAIL_TRAIL 30
+
+#define DEFAULT_FRAMES 1800
+#define MAX_THREADS 256
+
+// The knobs being swept, plus what came out
+typedef struct Result {
+    double startAngleChange;
+    double angleAccel;
+    int shootRate;
+
+    double coverage;
+    double evenness;
+    int period;
+    double score;
+} Result;
+
+// Everything projectilePattern.c kept in globals
+typedef struct Instance {
+    Bullet bullets[MAX_BULLETS];
+    double x;
+    double y;
+    double angle;
+    double angleChange;
+    double angleAccel;
+    int shootRate;
+    int frameCounter;
+    int curBullet;
+} Instance;
+
+void initInstance(Instance *inst, const Result *params);
+void stepInstance(Instance *inst, float *shotAngle);
+void runInstance(Result *result, int frames);
+int findPeriod(const float *shots, int count);
+void *worker(void *arg);
+void writeThumbnail(const Result *result, int frames, int rank);
+int compareScores(const void *a, const void *b);
+double wallTime(void);
+
+Result *results;
+int numResults;
+int numFrames = DEFAULT_FRAMES;
+atomic_int nextJob;
+
+int main(int argc, char **argv) {
+    if (argc > 1) { numFrames = atoi(argv[1]); }
+    if (numFrames < 2) { numFrames = 2; }
+
+    int numThreads = (argc > 2) ? atoi(argv[2]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (numThreads < 1) { numThreads = 1; }
+    if (numThreads > MAX_THREADS) { numThreads = MAX_THREADS; }
+
+    // Build the grid of parameters
+    const double accels[] = {0, 0.00625, 0.0125, 0.025, 0.05, 0.1};
+    const int numAccels = sizeof(accels) / sizeof(accels[0]);
+
+    numResults = 0;
+    results = malloc(sizeof(Result) * 80 * numAccels * 8);
+
+    for (int a = 0; a < 80; a++) {
+        for (int c = 0; c < numAccels; c++) {
+            for (int s = 1; s <= 8; s++) {
+                results[numResults] = (Result) {0};
+                results[numResults].startAngleChange = 1 + (a * 0.5);
+                results[numResults].angleAccel = accels[c];
+                results[numResults].shootRate = s;
+                numResults++;
+            }
+        }
+    }
+
+    printf("%d runs of %d frames on %d threads\n", numResults, numFrames, numThreads);
+
+    double start = wallTime();
+
+    // Every thread grabs the next job number until there are none left, so slow runs don't hold up a whole block
+    atomic_store(&nextJob, 0);
+
+    // Only the threads that actually started get joined, and if none did this thread does all the jobs itself
+    pthread_t threads[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < numThreads; t++) {
+        if (pthread_create(&threads[started], NULL, worker, NULL) != 0) {
+            TraceLog(LOG_WARNING, "SWEEP: could not start thread %d", t);
+            continue;
+        }
+        started++;
+    }
+
+    if (started == 0) {
+        worker(NULL);
+    }
+
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    printf("done in %.2f s\n", wallTime() - start);
+
+    qsort(results, numResults, sizeof(Result), compareScores);
+
+    FILE *csv = fopen("sweep_results.csv", "w");
+    if (csv == NULL) {
+        TraceLog(LOG_ERROR, "SWEEP: could not write sweep_results.csv");
+    }
+    else {
+        fprintf(csv, "rank,angleChange,angleAccel,shootRate,coverage,evenness,period,score\n");
+        for (int i = 0; i < numResults; i++) {
+            fprintf(csv, "%d,%.3f,%.5f,%d,%.4f,%.4f,%d,%.4f\n", i + 1, results[i].startAngleChange, results[i].angleAccel,
+                    results[i].shootRate, results[i].coverage, results[i].evenness, results[i].period, results[i].score);
+        }
+        fclose(csv);
+    }
+
+    printf("rank  angleChange  accel    shootRate  coverage  evenness  period  score\n");
+    for (int i = 0; i < THUMBNAIL_COUNT && i < numResults; i++) {
+        printf("%4d  %11.2f  %.5f  %9d  %8.3f  %8.3f  %6d  %.3f\n", i + 1, results[i].startAngleChange, results[i].angleAccel,
+               results[i].shootRate, results[i].coverage, results[i].evenness, results[i].period, results[i].score);
+
+        writeThumbnail(&results[i], numFrames, i + 1);
+    }
+
+    free(results);
+
+    return 0;
+}
+
+void *worker(void *arg) {
+    (void) arg;
+
+    while (true) {
+        int job = atomic_fetch_add(&nextJob, 1);
+        if (job >= numResults) {
+            break;
+        }
+
+        runInstance(&results[job], numFrames);
+    }
+
+    return NULL;
+}
+
+void initInstance(Instance *inst, const Result *params) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        inst->bullets[i].centreX = SCREEN_WIDTH / 2;
+        inst->bullets[i].centreY = SCREEN_HEIGHT / 2;
+        inst->bullets[i].velocity = (Vector2) {0, 0};
+        inst->bullets[i].isActive = false;
+    }
+
+    inst->angle = 1;
+    inst->angleChange = params->startAngleChange;
+    inst->angleAccel = params->angleAccel;
+    inst->shootRate = params->shootRate;
+    inst->frameCounter = 0;
+    inst->curBullet = 0;
+}
+
+// One update() from projectilePattern.c, minus the keys. shotAngle gets the angle fired at, or -1 for no shot.
+void stepInstance(Instance *inst, float *shotAngle) {
+    double radianAngle = inst->angle * (PI / 180.0);
+
+    inst->x = cos(radianAngle);
+    inst->y = sin(radianAngle);
+
+    *shotAngle = -1;
+
+    inst->angle += inst->angleChange;
+    if (inst->angle > 360) { inst->angle = inst->angle - 360; }
+
+    inst->angleChange += inst->angleAccel;
+
+    inst->frameCounter++;
+    if (inst->frameCounter > 60) { inst->frameCounter = 1; }
+
+    if (inst->frameCounter % inst->shootRate == 0) {
+        Bullet *b = &inst->bullets[inst->curBullet];
+
+        b->centreX = SCREEN_WIDTH / 2;
+        b->centreY = SCREEN_HEIGHT / 2;
+        b->velocity.x = BULLET_VELOCITY * inst->x;
+        b->velocity.y = BULLET_VELOCITY * inst->y;
+        b->isActive = true;
+
+        *shotAngle = fmod(radianAngle * RAD2DEG, 360.0);
+
+        inst->curBullet++;
+        if (inst->curBullet >= MAX_BULLETS) { inst->curBullet = 0; }
+    }
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        Bullet *b = &inst->bullets[i];
+
+        if (!b->isActive) {
+            continue;
+        }
+
+        b->centreX += b->velocity.x;
+        b->centreY += b->velocity.y;
+
+        if (b->centreX >= SCREEN_WIDTH || b->centreX < 0 || b->centreY >= SCREEN_HEIGHT || b->centreY < 0) {
+            b->centreX = SCREEN_WIDTH / 2;
+            b->centreY = SCREEN_HEIGHT / 2;
+            b->velocity = (Vector2) {0, 0};
+            b->isActive = false;
+        }
+    }
+}
+
+void runInstance(Result *result, int frames) {
+    Instance *inst = malloc(sizeof(Instance));
+    float *shots = malloc(sizeof(float) * frames);
+    int numShots = 0;
+
+    long cells[COVER_WIDTH * COVER_HEIGHT] = {0};
+
+    initInstance(inst, result);
+
+    for (int f = 0; f < frames; f++) {
+        float shotAngle;
+        stepInstance(inst, &shotAngle);
+
+        // Warm-up: the screen starts empty, so the first half isn't counted
+        if (f < frames / 2) {
+            continue;
+        }
+
+        if (shotAngle >= 0) {
+            shots[numShots] = shotAngle;
+            numShots++;
+        }
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (inst->bullets[i].isActive) {
+                int cx = (int) inst->bullets[i].centreX / COVER_CELL;
+                int cy = (int) inst->bullets[i].centreY / COVER_CELL;
+
+                if (cx >= 0 && cx < COVER_WIDTH && cy >= 0 && cy < COVER_HEIGHT) {
+                    cells[(cy * COVER_WIDTH) + cx]++;
+                }
+            }
+        }
+    }
+
+    int covered = 0;
+    double sum = 0;
+    double sumSquares = 0;
+
+    for (int c = 0; c < COVER_WIDTH * COVER_HEIGHT; c++) {
+        if (cells[c] > 0) { covered++; }
+        sum += cells[c];
+        sumSquares += (double) cells[c] * cells[c];
+    }
+
+    double mean = sum / (COVER_WIDTH * COVER_HEIGHT);
+    double variance = (sumSquares / (COVER_WIDTH * COVER_HEIGHT)) - (mean * mean);
+
+    result->coverage = (double) covered / (COVER_WIDTH * COVER_HEIGHT);
+    result->evenness = (mean > 0) ? 1.0 / (1.0 + variance / (mean * mean)) : 0;
+    result->period = findPeriod(shots, numShots);
+    result->score = result->coverage * result->evenness;
+
+    free(shots);
+    free(inst);
+}
+
+/*
+Smallest lag (in shots) where every shot lines up with the one lag shots before it, to within PERIOD_TOLERANCE degrees.
+Most lags fail on the first comparison or two, so this is a lot cheaper than it looks.
+*/
+int findPeriod(const float *shots, int count) {
+    for (int lag = 1; lag <= MAX_PERIOD && lag * 2 <= count; lag++) {
+        bool repeats = true;
+
+        for (int i = lag; i < count; i++) {
+            double diff = fabs(shots[i] - shots[i - lag]);
+            if (diff > 180) { diff = 360 - diff; }
+
+            if (diff > PERIOD_TOLERANCE) {
+                repeats = false;
+                break;
+            }
+        }
+
+        if (repeats) {
+            return lag;
+        }
+    }
+
+    return 0;
+}
+
+// Runs the winner again and overlays its last THUMBNAIL_TRAIL frames, so you can see the shape and not just dots
+void writeThumbnail(const Result *result, int frames, int rank) {
+    Instance *inst = malloc(sizeof(Instance));
+    Image thumb = GenImageColor(SCREEN_WIDTH / THUMBNAIL_SCALE, SCREEN_HEIGHT / THUMBNAIL_SCALE, RAYWHITE);
+
+    initInstance(inst, result);
+
+    for (int f = 0; f < frames; f++) {
+        float shotAngle;
+        stepInstance(inst, &shotAngle);
+
+        if (f < frames - THUMBNAIL_TRAIL) {
+            continue;
+        }
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (inst->bullets[i].isActive) {
+                ImageDrawPixel(&thumb, inst->bullets[i].centreX / THUMBNAIL_SCALE, inst->bullets[i].centreY / THUMBNAIL_SCALE, BLACK);
+            }
+        }
+    }
+
+    ExportImage(thumb, TextFormat("sweep_%02d.png", rank));
+
+    UnloadImage(thumb);
+    free(inst);
+}
+
+// Best score first
+int compareScores(const void *a, const void *b) {
+    double diff = ((const Result *) b)->score - ((const Result *) a)->score;
+
+    return (diff > 0) - (diff < 0);
+}
+
+// GetTime() needs a window, and there isn't one here
+double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + (now.tv_nsec / 1000000000.0);
+}
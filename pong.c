@@ -13,14 +13,22 @@
     This happens because you just add a velocity to the position, so unless you have a billion calls for update, the position will just skip pixels if speed != 0
     Therefore, to handle this, you can use a range to check if the ball would be at the paddle or inside, then rebound - this way the ball wont pass through
         after that, you need to make sure that you set a max speed, because if the paddle with is constant but the speed goes up infinitely, it will eventually reach a speed that is greater than the width of teh paddle and pass through
+
+    Serving and idling - October 2026
+    After every point (and at the start) the ball waits in the middle until you press W, S or SPACE.
+    While it waits nothing on screen moves, so instead of redrawing the same frame 60 times a second the loop skips drawing
+    and sleeps until there is input. update() works out whether anything moved by comparing before and after.
     
 */
 
 #include "raylib.h"
 
+#include <stdbool.h>
+
 void initialize();
 void update();
 void draw();
+void waitForInput();
 
 typedef struct Paddle {
     int x;
@@ -49,6 +57,18 @@ int screenHeight = 400;
 int playerScore = 0;
 int computerScore = 0;
 
+// The ball sits still until the player serves
+bool serving = true;
+
+// Set by update() when anything on screen moved, starts true so the first frame gets drawn
+bool changed = true;
+
+// Idle stats - frames where nothing changed and we slept instead of drawing
+long drawnFrames = 0;
+long idleFrames = 0;
+double idleTime = 0;
+double startTime = 0;
+
 int main(void) {
 
     Paddle player;
@@ -63,9 +83,18 @@ int main(void) {
         update(&player, &computer, &ball);
 
         // maybe you could have a game elements array, then go through each one and draw them
-        draw(player, computer, ball);
+        if (changed) {
+            draw(player, computer, ball);
+            changed = false;
+        }
+        else {
+            waitForInput();
+        }
     }
 
+    TraceLog(LOG_INFO, "IDLE: %ld frames drawn, %ld skipped, %.1f of %.1f s asleep",
+             drawnFrames, idleFrames, idleTime, GetTime() - startTime);
+
     CloseWindow();
 
     return 0;
@@ -87,10 +116,22 @@ void initialize(Paddle *player, Paddle *computer, Ball *ball) {
     ball->yVelocity = INIT_BALL_VELOCITY;
 
     SetTargetFPS(60);
+
+    startTime = GetTime();
 }
 
 void update(Paddle *player, Paddle *computer, Ball *ball) {
 
+    // to tell if anything moved by the end
+    Paddle oldPlayer = *player;
+    Paddle oldComputer = *computer;
+    Ball oldBall = *ball;
+    int oldScore = playerScore + computerScore;
+
+    if (serving && (IsKeyDown(KEY_W) || IsKeyDown(KEY_S) || IsKeyPressed(KEY_SPACE))) {
+        serving = false;
+    }
+
     // player input section
     if (IsKeyDown(KEY_W)) {
         if (player->y == 0) {
@@ -131,7 +172,10 @@ void update(Paddle *player, Paddle *computer, Ball *ball) {
         }
     }
 
-    if (ball->x + BALL_LENGTH >= screenWidth) {
+    if (serving) {
+        // the ball doesn't move until the serve, so none of the ball stuff below happens
+    }
+    else if (ball->x + BALL_LENGTH >= screenWidth) {
         // computer lost
 
         // reset speeds and position of ball and players
@@ -147,6 +191,7 @@ void update(Paddle *player, Paddle *computer, Ball *ball) {
         computer->y = (screenHeight / 2) - (PADDLE_HEIGHT / 2);
 
         playerScore++;
+        serving = true;
     }
     else if (ball->x <= 0) {
         // player lost
@@ -162,10 +207,14 @@ void update(Paddle *player, Paddle *computer, Ball *ball) {
         computer->y = (screenHeight / 2) - (PADDLE_HEIGHT / 2);
         
         computerScore++;
+        serving = true;
     }
 
     // Bounce ball if it hits the top of the screen
-    if ((ball->y + BALL_LENGTH >= screenHeight) || (ball->y <= 0)) {
+    if (serving) {
+        // still waiting
+    }
+    else if ((ball->y + BALL_LENGTH >= screenHeight) || (ball->y <= 0)) {
         ball->yVelocity = -(ball->yVelocity);
     }
 
@@ -211,8 +260,16 @@ void update(Paddle *player, Paddle *computer, Ball *ball) {
     }
 
     // the actual movement of the ball
-    ball->y -= ball->yVelocity;
-    ball->x += ball->xVelocity;
+    if (!serving) {
+        ball->y -= ball->yVelocity;
+        ball->x += ball->xVelocity;
+    }
+
+    changed = changed ||
+              player->x != oldPlayer.x || player->y != oldPlayer.y ||
+              computer->x != oldComputer.x || computer->y != oldComputer.y ||
+              ball->x != oldBall.x || ball->y != oldBall.y ||
+              playerScore + computerScore != oldScore;
 }
 
 void draw(Paddle player, Paddle computer, Ball ball) {
@@ -227,6 +284,28 @@ void draw(Paddle player, Paddle computer, Ball ball) {
         DrawText(TextFormat("%d", playerScore), screenWidth / 2 - 20, 20, 20, WHITE);
         DrawText(TextFormat("%d", computerScore), screenWidth / 2 + 20, 20, 20, WHITE);
 
+        if (serving) {
+            DrawText("W / S / SPACE to serve", screenWidth / 2 - 120, screenHeight - 60, 20, GRAY);
+        }
+
+        // only updated when we draw anyway, otherwise the stats themselves would count as a change
+        double totalTime = GetTime() - startTime;
+        DrawText(TextFormat("idle %.0f%%, %ld frames skipped", (totalTime > 0) ? 100.0 * idleTime / totalTime : 0, idleFrames),
+                 10, screenHeight - 20, 10, DARKGRAY);
 
     EndDrawing();
+
+    drawnFrames++;
+}
+
+// nothing changed, so the last frame is still on screen - sleep until there is some input, then let update() look at it
+void waitForInput() {
+    double start = GetTime();
+
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+
+    idleTime += GetTime() - start;
+    idleFrames++;
 }
@@ -1,11 +1,28 @@
 #include "raylib.h"
+#include "rlgl.h"
 #include <math.h>
 #include <stdbool.h>
+#include <stdio.h>
+
+#if !defined(_WIN32)
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
 
 void initialize();
 void update();
 void draw();
-void getVelocities(int index);
+void shoot(double offsetAngle);
+void getVelocities(int index, double offsetAngle);
+void governFrame();
+void applyLevel(int newLevel, double work);
+void openMetrics();
+void serveMetrics();
+void closeMetrics();
 
 typedef struct Bullet {
     double centreX;
@@ -14,9 +31,49 @@ typedef struct Bullet {
     bool isActive;
 } Bullet;
 
-#define MAX_BULLETS 500
+#define MAX_BULLETS 16384
 #define BULLET_VELOCITY 5
 #define RADIUS 50
+#define MAX_EMITTERS 64
+
+/*
+    governor
+    watches how long the whole frame took (frameWork: update, draw, the batch flush and the buffer swap in EndDrawing, everything
+    but the wait for the next frame) against frameBudget, and when it keeps going over
+    it turns things down one level at a time, cheapest to lose first:
+        level 1         HUD text only rebuilt every HUD_SLOW_FRAMES frames
+        level 2         bullets drawn as squares instead of circles
+        level 3 - 5     emitters halved per level (never below 1)
+        level 6 - 8     shootRate x2, x3, x4
+    hysteresis, so it doesn't flip back and forth every frame:
+        up a level when the smoothed work has been over GOVERNOR_HIGH of the budget for GOVERNOR_UP_FRAMES frames in a row
+        down a level only when it has been under GOVERNOR_LOW for GOVERNOR_DOWN_FRAMES frames in a row
+    and both counters and the smoothing start over after every change, so the new level gets measured on its own before the next one
+    (otherwise the smoothed work would still be mostly the old level's for the first 1 / GOVERNOR_SMOOTHING frames)
+    every change goes to the log with the numbers that caused it
+*/
+#define FRAME_BUDGET_MS 16.6
+#define TARGET_FPS 60
+#define GOVERNOR_MAX_LEVEL 8
+#define GOVERNOR_HIGH 0.9
+#define GOVERNOR_LOW 0.6
+#define GOVERNOR_UP_FRAMES 10
+#define GOVERNOR_DOWN_FRAMES 120
+#define GOVERNOR_SMOOTHING 0.1
+#define HUD_SLOW_FRAMES 15
+
+/*
+    metrics
+    anything that connects to this socket gets the current numbers as text, one "name value" per line, then the socket is closed
+    eg. socat - UNIX-CONNECT:/tmp/projectilePattern.sock
+
+    we only check for a waiting connection every METRICS_POLL_FRAMES frames, so if nobody is reading it costs one accept() call a few times a second
+    the counters themselves are just ints that get bumped as things happen
+    draw_seconds is only the CPU side of draw (the DrawX calls filling raylib's batch), flush_seconds is sending that batch to the GPU,
+    neither has the buffer swap or the wait for the next frame in it, and the GPU runs the draw calls on its own time after that
+*/
+#define METRICS_SOCKET_PATH "/tmp/projectilePattern.sock"
+#define METRICS_POLL_FRAMES 15
 
 const int screenWidth = 800;
 const int screenHeight = 450;
@@ -31,6 +88,35 @@ int curBullet;
 int shootRate = 4;
 int numBullets = 0;
 
+// what you asked for with the keys, the governor works out shootRate and numEmitters from these
+int wantedShootRate = 4;
+int wantedEmitters = 1;
+
+// governor
+bool governorOn = true;
+double frameBudget = FRAME_BUDGET_MS / 1000.0;
+double smoothedWork = 0;
+int governorLevel = 0;
+int framesOver = 0;
+int framesUnder = 0;
+bool reseedWork = true;
+bool cheapBullets = false;
+int hudInterval = 1;
+long hudFrame = 0;
+char hudText[256] = "";
+
+// metrics - numBullets above is the active bullet gauge
+long spawnedBullets = 0;
+long expiredBullets = 0;
+long overwrittenBullets = 0;
+int numEmitters = 1;
+double tickTime = 0;
+double drawTime = 0;
+double flushTime = 0;
+double frameWork = 0;
+long metricsFrame = 0;
+int metricsSocket = -1;
+
 Bullet bullets[MAX_BULLETS];
 
 int main() 
@@ -39,11 +125,28 @@ int main()
 
     while (!WindowShouldClose())
     {
+        double start = GetTime();
         update();
+        tickTime = GetTime() - start;
 
         draw();
+
+        frameWork = GetTime() - start;
+
+        governFrame();
+
+        serveMetrics();
+
+        // the frame is paced here instead of with SetTargetFPS, which waits inside EndDrawing where the wait can't be told apart
+        // from the swap (vsync is off, so the swap itself doesn't wait either)
+        double left = 1.0 / TARGET_FPS - (GetTime() - start);
+        if (left > 0) {
+            WaitTime(left);
+        }
     }
 
+    closeMetrics();
+
     CloseWindow();
 
     return 0;
@@ -51,7 +154,7 @@ int main()
 
 void initialize() {
     InitWindow(screenWidth, screenHeight, "raylib");
-    SetTargetFPS(60);
+    // no SetTargetFPS, main() waits out the rest of each frame itself
     
     angle = 1;
 
@@ -64,6 +167,8 @@ void initialize() {
 
     frameCounter = 0;
     curBullet = 0;
+
+    openMetrics();
 }
 
 void update() {
@@ -72,9 +177,25 @@ void update() {
     if (angleChange < 1) { angleChange = 1; }
     if (IsKeyPressed(KEY_R)) { angleChange = 1; }
 
-    if (IsKeyPressed(KEY_UP)) { shootRate++; }
-    if (IsKeyPressed(KEY_DOWN)) { shootRate--; }
-    if (shootRate < 1) { shootRate = 1; }
+    if (IsKeyPressed(KEY_UP)) { wantedShootRate++; }
+    if (IsKeyPressed(KEY_DOWN)) { wantedShootRate--; }
+    if (wantedShootRate < 1) { wantedShootRate = 1; }
+
+    if (IsKeyPressed(KEY_E)) { wantedEmitters *= 2; }
+    if (IsKeyPressed(KEY_Q)) { wantedEmitters /= 2; }
+    if (wantedEmitters < 1) { wantedEmitters = 1; }
+    if (wantedEmitters > MAX_EMITTERS) { wantedEmitters = MAX_EMITTERS; }
+
+    if (IsKeyPressed(KEY_G)) {
+        governorOn = !governorOn;
+        applyLevel(0, smoothedWork);
+    }
+    if (IsKeyPressed(KEY_RIGHT_BRACKET)) { frameBudget += 0.001; }
+    if (IsKeyPressed(KEY_LEFT_BRACKET)) { frameBudget -= 0.001; }
+    if (frameBudget < 0.001) { frameBudget = 0.001; }
+
+    // the keys can change in between governor steps, so this is worked out every frame
+    applyLevel(governorLevel, smoothedWork);
 
     // Getting point on orbit
     radianAngle = angle * (PI / 180.0);
@@ -103,14 +224,11 @@ void update() {
     frameCounter++;
     if (frameCounter > 60) { frameCounter = 1; }
 
-    // note: if you want to shoot multiple times per frame, use a for loop [do the things inside this if statement, incrament angle and do it again]
+    // more emitters = more shots per frame, spread evenly around from the orbiter's direction
     if (frameCounter % shootRate == 0) {
-        getVelocities(curBullet);
-        bullets[curBullet].isActive = true;
-
-        curBullet++;
-        if (curBullet > MAX_BULLETS) { curBullet = 0; }
-        numBullets++;
+        for (int i = 0; i < numEmitters; i++) {
+            shoot(i * (2 * PI / numEmitters));
+        }
     }
 
     // update position
@@ -122,31 +240,60 @@ void update() {
         }
 
         // If bullet at edge, make it stop moving and move it back to the emitter
-        if (bullets[i].centreX >= screenWidth || bullets[i].centreX < 0 ||
-            bullets[i].centreY >= screenHeight || bullets[i].centreY < 0) {
+        // only active bullets can expire, idle ones were never counted
+        if (bullets[i].isActive &&
+            (bullets[i].centreX >= screenWidth || bullets[i].centreX < 0 ||
+             bullets[i].centreY >= screenHeight || bullets[i].centreY < 0)) {
             
                 bullets[i].centreX = screenWidth / 2;
                 bullets[i].centreY = screenHeight / 2;
                 bullets[i].velocity = (Vector2) {0, 0};
                 bullets[i].isActive = false;
                 numBullets--;
+                expiredBullets++;
         }
     }
     
 }
 
-// Your basic similar triangle velocity method
-void getVelocities(int index) {
+void shoot(double offsetAngle) {
+    // if the ring has come all the way around to a bullet that is still flying, it gets reused, so it was already counted
+    if (bullets[curBullet].isActive) {
+        overwrittenBullets++;
+    }
+    else {
+        numBullets++;
+    }
+    spawnedBullets++;
+
+    // the bullet starts from the emitter, even if it was reused mid-flight
+    bullets[curBullet].centreX = screenWidth / 2;
+    bullets[curBullet].centreY = screenHeight / 2;
+    getVelocities(curBullet, offsetAngle);
+    bullets[curBullet].isActive = true;
+
+    curBullet++;
+    // >= not >, bullets[MAX_BULLETS] is past the end of the array
+    if (curBullet >= MAX_BULLETS) { curBullet = 0; }
+}
+
+// Your basic similar triangle velocity method, then turned by offsetAngle (radians) for the extra emitters
+void getVelocities(int index, double offsetAngle) {
     double deltaX = x - (screenWidth / 2);
     double deltaY = y - (screenHeight / 2);
 
     double ratio = BULLET_VELOCITY / sqrt((deltaX * deltaX) + (deltaY * deltaY));
 
-    bullets[index].velocity.x = deltaX * ratio;
-    bullets[index].velocity.y = deltaY * ratio;
+    double velocityX = deltaX * ratio;
+    double velocityY = deltaY * ratio;
+
+    bullets[index].velocity.x = velocityX * cos(offsetAngle) - velocityY * sin(offsetAngle);
+    bullets[index].velocity.y = velocityX * sin(offsetAngle) + velocityY * cos(offsetAngle);
 }
 
 void draw() {
+    double start = GetTime();
+
     BeginDrawing();
 
         ClearBackground(RAYWHITE);
@@ -157,14 +304,192 @@ void draw() {
         // The orbiter
         DrawCircle(x, y, 5, YELLOW);
 
-        // Draw all active bullets
+        // Draw all active bullets, a square is 2 triangles where a circle is 36
         for (int i = 0; i < MAX_BULLETS; i++) {
             if (bullets[i].isActive) {
-                DrawCircle(bullets[i].centreX, bullets[i].centreY, 5, BLACK);
+                if (cheapBullets) {
+                    DrawRectangle(bullets[i].centreX - 4, bullets[i].centreY - 4, 8, 8, BLACK);
+                }
+                else {
+                    DrawCircle(bullets[i].centreX, bullets[i].centreY, 5, BLACK);
+                }
             }
         }
 
-        DrawText(TextFormat("%d", numBullets), 50, 50, 20, BLACK);
+        // the numbers only get formatted every hudInterval frames, in between the old text is drawn again
+        if (hudFrame++ % hudInterval == 0 || hudText[0] == '\0') {
+            snprintf(hudText, sizeof(hudText), "%d\n\nemitters %d / %d, shootRate %d / %d\nwork %.2f of %.2f ms, governor %s, level %d",
+                     numBullets, numEmitters, wantedEmitters, shootRate, wantedShootRate, smoothedWork * 1000.0, frameBudget * 1000.0,
+                     governorOn ? "on" : "off", governorLevel);
+        }
+
+        DrawText(hudText, 50, 50, 20, BLACK);
+
+    // measured before EndDrawing, so it is only the CPU side, the flush and swap are timed separately below and in main()
+    drawTime = GetTime() - start;
+
+    // EndDrawing would flush the batch too, doing it here first lets it be timed on its own, without the wait
+    double flushStart = GetTime();
+    rlDrawRenderBatchActive();
+    flushTime = GetTime() - flushStart;
 
     EndDrawing();
 }
+
+/*
+    called once a frame, after update and draw, with the time the frame just took
+    the smoothing is there so one slow frame (a hitch from the OS, a window move) doesn't cost a level on its own
+*/
+void governFrame() {
+    // the first frame after a level change starts the average over, instead of blending into the old level's numbers
+    if (reseedWork) {
+        smoothedWork = frameWork;
+        reseedWork = false;
+    }
+    else {
+        smoothedWork += (frameWork - smoothedWork) * GOVERNOR_SMOOTHING;
+    }
+
+    if (!governorOn) {
+        return;
+    }
+
+    if (smoothedWork > frameBudget * GOVERNOR_HIGH) {
+        framesOver++;
+        framesUnder = 0;
+    }
+    else if (smoothedWork < frameBudget * GOVERNOR_LOW) {
+        framesUnder++;
+        framesOver = 0;
+    }
+    else {
+        // in the band, stay where we are
+        framesOver = 0;
+        framesUnder = 0;
+    }
+
+    if (framesOver >= GOVERNOR_UP_FRAMES && governorLevel < GOVERNOR_MAX_LEVEL) {
+        applyLevel(governorLevel + 1, smoothedWork);
+    }
+    else if (framesUnder >= GOVERNOR_DOWN_FRAMES && governorLevel > 0) {
+        applyLevel(governorLevel - 1, smoothedWork);
+    }
+}
+
+// works out every setting from the level and what was asked for, and logs it if the level changed
+void applyLevel(int newLevel, double work) {
+    int emitterDivisor = 1;
+    int rateMultiplier = 1;
+
+    if (newLevel >= 3) { emitterDivisor = 1 << ((newLevel < 5 ? newLevel : 5) - 2); }
+    if (newLevel >= 6) { rateMultiplier = newLevel - 4; }
+
+    hudInterval = (newLevel >= 1) ? HUD_SLOW_FRAMES : 1;
+    cheapBullets = newLevel >= 2;
+    numEmitters = wantedEmitters / emitterDivisor;
+    if (numEmitters < 1) { numEmitters = 1; }
+    shootRate = wantedShootRate * rateMultiplier;
+
+    if (newLevel != governorLevel) {
+        TraceLog(LOG_INFO, "GOVERNOR: level %d -> %d (work %.2f ms, budget %.2f ms): emitters %d, shootRate %d, %s bullets, HUD every %d frames",
+                 governorLevel, newLevel, work * 1000.0, frameBudget * 1000.0, numEmitters, shootRate,
+                 cheapBullets ? "square" : "round", hudInterval);
+
+        governorLevel = newLevel;
+        framesOver = 0;
+        framesUnder = 0;
+        reseedWork = true;
+
+        // the HUD shows the new level straight away, even if it is only being rebuilt now and then
+        hudText[0] = '\0';
+    }
+}
+
+#if !defined(_WIN32)
+
+void openMetrics() {
+    struct sockaddr_un address = { 0 };
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", METRICS_SOCKET_PATH);
+
+    // a reader that hangs up early would otherwise kill the game on the next write
+    signal(SIGPIPE, SIG_IGN);
+
+    metricsSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (metricsSocket < 0) {
+        TraceLog(LOG_WARNING, "METRICS: could not create socket, metrics are off");
+        return;
+    }
+
+    // left over from last run
+    unlink(METRICS_SOCKET_PATH);
+
+    if (bind(metricsSocket, (struct sockaddr *) &address, sizeof(address)) < 0 || listen(metricsSocket, 4) < 0) {
+        TraceLog(LOG_WARNING, "METRICS: could not listen on %s, metrics are off", METRICS_SOCKET_PATH);
+        close(metricsSocket);
+        metricsSocket = -1;
+        return;
+    }
+
+    // accept() has to return straight away when nobody is there
+    fcntl(metricsSocket, F_SETFL, fcntl(metricsSocket, F_GETFL, 0) | O_NONBLOCK);
+
+    TraceLog(LOG_INFO, "METRICS: serving on %s", METRICS_SOCKET_PATH);
+}
+
+void serveMetrics() {
+    metricsFrame++;
+
+    if (metricsSocket < 0 || metricsFrame % METRICS_POLL_FRAMES != 0) {
+        return;
+    }
+
+    // answer everyone who connected since the last check
+    while (true) {
+        int client = accept(metricsSocket, NULL, NULL);
+
+        if (client < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                TraceLog(LOG_WARNING, "METRICS: accept failed (%d)", errno);
+            }
+            return;
+        }
+
+        char text[512];
+        int length = snprintf(text, sizeof(text),
+            "bullets_active %d\n"
+            "bullets_spawned_total %ld\n"
+            "bullets_expired_total %ld\n"
+            "bullets_overwritten_total %ld\n"
+            "emitters %d\n"
+            "tick_seconds %.9f\n"
+            "draw_seconds %.9f\n"
+            "flush_seconds %.9f\n"
+            "governor_level %d\n",
+            numBullets, spawnedBullets, expiredBullets, overwrittenBullets, numEmitters, tickTime, drawTime, flushTime, governorLevel);
+
+        // it all fits in one write, and if the reader is too slow to take 200 bytes we just drop it
+        if (write(client, text, length) < 0) {
+            TraceLog(LOG_DEBUG, "METRICS: reader went away");
+        }
+
+        close(client);
+    }
+}
+
+void closeMetrics() {
+    if (metricsSocket >= 0) {
+        close(metricsSocket);
+        unlink(METRICS_SOCKET_PATH);
+        metricsSocket = -1;
+    }
+}
+
+#else
+
+// no unix sockets, so no metrics
+void openMetrics() {}
+void serveMetrics() {}
+void closeMetrics() {}
+
+#endif
@@ -0,0 +1,263 @@
+/*
+Rapid Fire - October 2026
+
+An updated version of "projectilePattern.c"
+The fire rate is now in bullets per second instead of "every shootRate frames", so it can go way past one bullet a frame.
+
+The old way had two problems:
+    1. frameCounter goes 1 -> 60 then back to 1, so 60 % 4 == 0 and then 4 % 4 == 0 again, and the gap at the wrap is uneven
+    2. the most you can shoot is one bullet per frame
+
+Now each emitter keeps track of when its next bullet is due, measured in ticks from the start of the current tick.
+Every tick, spawnBullets() works out all the bullets due before the end of the tick and writes them into the bullets
+array in one go. A bullet that was due a third of the way through the tick has already been flying for two thirds of a tick,
+so it is placed two thirds of a tick along its path, and its direction comes from where the orbiter was at that moment.
+That way the stream comes out evenly spaced no matter how the fire rate lines up with the frame rate.
+
+Controls:
+    A / D       orbiter angle change +1 / -1, R to reset it (same as projectilePattern.c)
+    UP / DOWN   double / halve the fire rate
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+int spawnBullets(int emitter);
+void writeBullets(int emitter, int first, int count, double dueTime);
+void resetBullet(int index);
+
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 450
+#define TICK_RATE 60
+#define NUM_EMITTERS 4
+#define MAX_BULLETS 32768
+#define BULLET_VELOCITY 5
+#define RADIUS 50
+#define MIN_FIRE_RATE 1
+#define MAX_FIRE_RATE 16384
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+// An emitter is one arm of the orbiter. All the arms share the orbit, they just start at different angles.
+typedef struct {
+    double angle;
+    double angleChange;
+
+    // In ticks, measured from the start of the current tick
+    double nextShot;
+
+    // Where the orbiter arm was at the start of the tick, so bullets due mid-tick can be aimed in between
+    double prevAngle;
+} Emitter;
+
+Emitter emitters[NUM_EMITTERS];
+Bullet bullets[MAX_BULLETS];
+
+// Same ring as the other demos. The batch writes start here and wrap back around to 0.
+int curBullet;
+int numActive;
+
+// Bullets per second, per emitter
+double fireRate = 240;
+
+double angleChange = 10;
+
+// Stats for the HUD
+int shotsThisTick;
+double spawnMs;
+
+int main() {
+
+    init();
+
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(TICK_RATE);
+
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        emitters[e].angle = 1 + (360.0 / NUM_EMITTERS) * e;
+        emitters[e].prevAngle = emitters[e].angle;
+        emitters[e].nextShot = 0;
+    }
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        resetBullet(i);
+    }
+
+    curBullet = 0;
+    numActive = 0;
+}
+
+void update(void) {
+    if (IsKeyPressed(KEY_A)) { angleChange++; }
+    if (IsKeyPressed(KEY_D)) { angleChange--; }
+    if (angleChange < 1) { angleChange = 1; }
+    if (IsKeyPressed(KEY_R)) { angleChange = 1; }
+
+    if (IsKeyPressed(KEY_UP)) { fireRate *= 2; }
+    if (IsKeyPressed(KEY_DOWN)) { fireRate /= 2; }
+    if (fireRate < MIN_FIRE_RATE) { fireRate = MIN_FIRE_RATE; }
+    if (fireRate > MAX_FIRE_RATE) { fireRate = MAX_FIRE_RATE; }
+
+    // Update position ===================================================
+    // Done before spawning, so that this tick's bullets aren't moved twice
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            bullets[i].position.x += bullets[i].velocity.x;
+            bullets[i].position.y += bullets[i].velocity.y;
+
+            if (bullets[i].position.x >= SCREEN_WIDTH || bullets[i].position.x < 0 ||
+                bullets[i].position.y >= SCREEN_HEIGHT || bullets[i].position.y < 0) {
+                resetBullet(i);
+                numActive--;
+            }
+        }
+    }
+
+    // Move the orbiter ==================================================
+    // Same as projectilePattern.c, the arms all turn by the same amount
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        emitters[e].prevAngle = emitters[e].angle;
+        emitters[e].angleChange = angleChange;
+        emitters[e].angle += angleChange;
+    }
+
+    angleChange += 0.025;
+
+    // Shoot =============================================================
+    double start = GetTime();
+    shotsThisTick = 0;
+
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        shotsThisTick += spawnBullets(e);
+    }
+
+    spawnMs = (GetTime() - start) * 1000.0;
+
+    // The wrap is done after shooting, so prevAngle -> angle never jumps by 360 in the middle of a tick
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        if (emitters[e].angle > 360) { emitters[e].angle -= 360; }
+    }
+}
+
+/*
+Shoots every bullet that is due this tick, and returns how many.
+If there are more than fit before the end of the array, the batch is split in two so each half is one straight run of writes.
+*/
+int spawnBullets(int emitter) {
+    Emitter *e = &emitters[emitter];
+    double interval = TICK_RATE / fireRate;
+
+    if (e->nextShot >= 1) {
+        e->nextShot -= 1;
+        return 0;
+    }
+
+    int count = (int) ((1 - e->nextShot) / interval);
+    if ((1 - e->nextShot) - count * interval > 0) { count++; }
+
+    int firstRun = MAX_BULLETS - curBullet;
+    if (firstRun > count) { firstRun = count; }
+
+    writeBullets(emitter, curBullet, firstRun, e->nextShot);
+    writeBullets(emitter, 0, count - firstRun, e->nextShot + firstRun * interval);
+
+    curBullet = (curBullet + count) % MAX_BULLETS;
+
+    e->nextShot += count * interval - 1;
+
+    return count;
+}
+
+/*
+Writes count bullets to bullets[first ...], the first of which was due dueTime ticks into this tick.
+Angles go up in equal steps, so instead of calling cos() and sin() per bullet we rotate the direction by a fixed step each time
+(the same rotation matrix from borderOfWaveAndParticle.c).
+*/
+void writeBullets(int emitter, int first, int count, double dueTime) {
+    if (count <= 0) {
+        return;
+    }
+
+    Emitter *e = &emitters[emitter];
+    double interval = TICK_RATE / fireRate;
+
+    double angle = (e->prevAngle + e->angleChange * dueTime) * DEG2RAD;
+    double step = e->angleChange * interval * DEG2RAD;
+
+    double dirX = cos(angle);
+    double dirY = sin(angle);
+    double stepCos = cos(step);
+    double stepSin = sin(step);
+
+    // How long the first bullet has already been flying, and how much less each one after it has
+    double age = 1 - dueTime;
+
+    for (int i = first; i < first + count; i++) {
+        if (!bullets[i].isActive) { numActive++; }
+
+        bullets[i].velocity.x = BULLET_VELOCITY * dirX;
+        bullets[i].velocity.y = BULLET_VELOCITY * dirY;
+        bullets[i].position.x = SCREEN_WIDTH / 2 + bullets[i].velocity.x * age;
+        bullets[i].position.y = SCREEN_HEIGHT / 2 + bullets[i].velocity.y * age;
+        bullets[i].isActive = true;
+
+        double x = (dirX * stepCos) - (dirY * stepSin);
+        dirY = (dirX * stepSin) + (dirY * stepCos);
+        dirX = x;
+
+        age -= interval;
+    }
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(RAYWHITE);
+
+        // The emitter
+        DrawCircle(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2, 5, BLACK);
+
+        // The orbiter arms
+        for (int e = 0; e < NUM_EMITTERS; e++) {
+            DrawCircle(SCREEN_WIDTH / 2 + RADIUS * cos(emitters[e].angle * DEG2RAD),
+                       SCREEN_HEIGHT / 2 + RADIUS * sin(emitters[e].angle * DEG2RAD), 5, YELLOW);
+        }
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                DrawCircleV(bullets[i].position, 2, BLACK);
+            }
+        }
+
+        DrawText(TextFormat("%.0f bullets/s per emitter", fireRate), 10, 10, 20, BLACK);
+        DrawText(TextFormat("%d shot this tick, %d active", shotsThisTick, numActive), 10, 35, 20, BLACK);
+        DrawText(TextFormat("spawn: %.3f ms", spawnMs), 10, 60, 20, BLACK);
+
+    EndDrawing();
+}
+
+void resetBullet(int index) {
+    bullets[index].position = (Vector2) {SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2};
+    bullets[index].velocity = (Vector2) {0, 0};
+    bullets[index].isActive = false;
+}
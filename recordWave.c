@@ -0,0 +1,834 @@
+/*
+Record Wave - October 2026
+
+"borderOfWaveAndParticle.c" with a recorder bolted on, so bullet runs can be analyzed offline.
+
+Usage:
+    recordWave [file] [--compress]          run the pattern and record every tick to file (default wave.traj)
+    recordWave --read file first last       print alive count and mean position for ticks first..last
+
+File layout:
+    TrajHeader      magic, sizes, and the block index (one TrajBlock per BLOCK_TICKS ticks)
+    blocks          one after another, straight after the header
+
+Each block is BLOCK_TICKS ticks stored a column at a time, so a reader after just x doesn't have to step over y, vx, vy:
+    alive bitmasks for every tick, then x for every tick, then y, then vx, then vy
+Only bullets that are alive get a value. Positions and velocities are stored as fixed point (1/POS_SCALE px, 1/VEL_SCALE px per tick)
+and each value is stored as the difference from the same bullet's value on the tick before, as a zigzag varint. Velocities hardly ever
+change, so they are almost always 1 byte. Positions change by the velocity, at 5 px a tick that is a delta of about 320 which zigzags to
+about 640, so they are mostly 2. The first tick of each block is against 0, so every block
+can be decoded on its own. With --compress each block also goes through raylib's CompressData().
+
+To read ticks 50000..50100 you binary search the index for the blocks that cover them and decode only those.
+
+The live loop only copies the tick into one of NUM_SLOTS raw blocks, which is about the same as one memcpy of the bullets array.
+A background thread does the encoding, compression and writing. If it falls behind and every slot is full, ticks are dropped
+(and counted) instead of making the game wait. The index entry for each block has its first tick, so the gaps show up in the file.
+
+POSIX only (mmap and pthreads).
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+void setTargets(void);
+void getVelocities(int bulIndex, int targIndex);
+void resetBullet(int index);
+
+bool openRecorder(const char *path, bool compress);
+void recordTick(void);
+void closeRecorder(void);
+void *writerThread(void *arg);
+int encodeBlock(int slot, uint8_t *out);
+bool decodeBlock(const uint8_t *in, int size, int numTicks);
+bool growFile(uint64_t size);
+int readRange(const char *path, int64_t first, int64_t last);
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define NUM_TARGETS 5
+#define MAX_BULLETS 1200
+#define MAX_VELOCITY 5
+
+#define TRAJ_MAGIC "BWPT"
+#define TRAJ_VERSION 1
+#define BLOCK_TICKS 64
+#define INDEX_CAPACITY 65536
+#define NUM_SLOTS 4
+#define MASK_BYTES ((MAX_BULLETS + 7) / 8)
+#define POS_SCALE 64.0f
+#define VEL_SCALE 4096.0f
+#define FILE_GROW (64 * 1024 * 1024)
+
+// Worst case for one encoded block: every mask, plus every bullet alive with a 5 byte varint in all 4 columns
+#define MAX_ENCODED (BLOCK_TICKS * MASK_BYTES + 4 * BLOCK_TICKS * MAX_BULLETS * 5)
+
+#define BLOCK_COMPRESSED 1
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+typedef struct TrajBlock {
+    int64_t firstTick;
+    uint64_t offset;
+    uint32_t storedSize;
+    uint32_t rawSize;
+    uint32_t numTicks;
+    uint32_t flags;
+} TrajBlock;
+
+typedef struct TrajHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t maxBullets;
+    uint32_t blockTicks;
+    uint64_t numBlocks;
+    uint64_t dataEnd;
+    TrajBlock index[INDEX_CAPACITY];
+} TrajHeader;
+
+// One block of ticks, as it was in the game
+typedef struct RawBlock {
+    int64_t firstTick;
+    int numTicks;
+    uint8_t alive[BLOCK_TICKS][MASK_BYTES];
+    float x[BLOCK_TICKS][MAX_BULLETS];
+    float y[BLOCK_TICKS][MAX_BULLETS];
+    float vx[BLOCK_TICKS][MAX_BULLETS];
+    float vy[BLOCK_TICKS][MAX_BULLETS];
+} RawBlock;
+
+typedef enum SlotState {
+    SLOT_FREE,
+    SLOT_FILLING,
+    SLOT_QUEUED
+} SlotState;
+
+typedef struct Recorder {
+    bool isOpen;
+    bool compress;
+    int fd;
+    TrajHeader *header;
+    uint64_t mappedSize;
+
+    // Set by the writer when the file couldn't grow. The old mapping is still there and still good, but nothing more gets written
+    bool failed;
+
+    RawBlock slots[NUM_SLOTS];
+    SlotState slotState[NUM_SLOTS];
+    int filling;
+
+    // Full slots waiting for the writer, oldest first
+    int queue[NUM_SLOTS];
+    int queueHead;
+    int queueCount;
+    bool stopping;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+
+    // The main thread can't look at the header (the writer may be remapping it), so the writer copies these out
+    int64_t tick;
+    int64_t droppedTicks;
+    uint64_t fileBytes;
+    uint64_t rawBytes;
+} Recorder;
+
+Vector2 targets[NUM_TARGETS];
+Bullet bullets[MAX_BULLETS];
+
+// curBullet is the latest bullet to be shot.
+// You can guarantee* that the next NUM_TARGET bullets after curBullet are free.
+int curBullet;
+
+float rotationAngle = 0;
+float deltaRAngle = 0.225f;
+
+Recorder recorder;
+
+// The reader decodes into this
+RawBlock decoded;
+
+int main(int argc, char **argv) {
+
+    if (argc >= 5 && strcmp(argv[1], "--read") == 0) {
+        return readRange(argv[2], atoll(argv[3]), atoll(argv[4]));
+    }
+
+    const char *path = "wave.traj";
+    bool compress = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--compress") == 0) { compress = true; }
+        else { path = argv[i]; }
+    }
+
+    init();
+
+    if (!openRecorder(path, compress)) {
+        TraceLog(LOG_WARNING, "RECORD: could not open %s, not recording", path);
+    }
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        recordTick();
+        draw();
+    }
+
+    closeRecorder();
+
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    setTargets();
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        resetBullet(i);
+    }
+}
+
+void update(void) {
+
+    // Update bullets ====================================================
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        // Updating position, if the bullet is active
+        if (bullets[i].isActive) {
+            bullets[i].position.x += bullets[i].velocity.x;
+            bullets[i].position.y += bullets[i].velocity.y;
+        }
+
+        // Test for out-of-bounds bullets
+        if (bullets[i].position.x > SCREEN_WIDTH / 2 || bullets[i].position.x < -SCREEN_WIDTH / 2) {
+            resetBullet(i);
+        }
+        else if (bullets[i].position.y > SCREEN_HEIGHT / 2 || bullets[i].position.y < -SCREEN_HEIGHT / 2) {
+            resetBullet(i);
+        }
+    }
+
+    // Shoot the bullet(s)
+    for (int i = 0; i < NUM_TARGETS; i++) {
+
+        bullets[curBullet].isActive = true;
+
+        getVelocities(curBullet, i);
+
+        bullets[curBullet].position = targets[i];
+
+        curBullet++;
+
+        if (curBullet >= MAX_BULLETS) {
+            curBullet = 0;
+        }
+    }
+
+    // Update targets ====================================================
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        // This is just an expanded rotation matrix multiplication
+        float xComponent = (targets[i].x * cos(rotationAngle * DEG2RAD)) -
+                           (targets[i].y * sin(rotationAngle * DEG2RAD));
+        float yComponent = (targets[i].x * sin(rotationAngle * DEG2RAD)) +
+                           (targets[i].y * cos(rotationAngle * DEG2RAD));
+        targets[i] = (Vector2) {xComponent, yComponent};
+    }
+
+    rotationAngle += deltaRAngle;
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            DrawCircle(targets[i].x + SCREEN_WIDTH / 2, targets[i].y + SCREEN_HEIGHT / 2, 5, YELLOW);
+        }
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                Vector2 tempPos = (Vector2) {bullets[i].position.x + SCREEN_WIDTH / 2, bullets[i].position.y + SCREEN_HEIGHT / 2};
+                DrawCircleV(tempPos, 5, PURPLE);
+            }
+        }
+
+        if (recorder.isOpen) {
+            double fileMb = __atomic_load_n(&recorder.fileBytes, __ATOMIC_RELAXED) / (1024.0 * 1024.0);
+            double rawMb = __atomic_load_n(&recorder.rawBytes, __ATOMIC_RELAXED) / (1024.0 * 1024.0);
+            long long dropped = __atomic_load_n(&recorder.droppedTicks, __ATOMIC_RELAXED);
+
+            DrawText(TextFormat("REC tick %lld, %.1f MB (%.1f MB raw), %lld ticks dropped",
+                                (long long) recorder.tick, fileMb, rawMb, dropped), 10, 10, 20, RED);
+
+            if (__atomic_load_n(&recorder.failed, __ATOMIC_RELAXED)) {
+                DrawText("REC FAILED: could not grow the file, the rest of the run is not being saved", 10, 35, 20, RED);
+            }
+        }
+
+    EndDrawing();
+}
+
+// Just your classic "n circular points made from rotating [1; 0] with a rotation matrix"
+void setTargets(void) {
+    float deltaAngle = 360 / NUM_TARGETS;
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float angle = (deltaAngle * i) * DEG2RAD;
+
+        targets[i].x = cos(angle);
+        targets[i].y = sin(angle);
+    }
+}
+
+// Just your classic similar triangles problem
+void getVelocities(int bulIndex, int targIndex) {
+    float deltaX = targets[targIndex].x;
+    float deltaY = targets[targIndex].y;
+
+    float hyp = sqrt( pow(deltaX, 2) + pow(deltaY, 2));
+
+    bullets[bulIndex].velocity.x = MAX_VELOCITY * (deltaX / hyp);
+    bullets[bulIndex].velocity.y = MAX_VELOCITY * (deltaY / hyp);
+}
+
+void resetBullet(int index) {
+    bullets[index].position = (Vector2) {0, 0};
+    bullets[index].velocity = (Vector2) {0, 0};
+    bullets[index].isActive = false;
+}
+
+// Recorder ==============================================================
+
+bool openRecorder(const char *path, bool compress) {
+    recorder.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (recorder.fd < 0) {
+        return false;
+    }
+
+    recorder.mappedSize = 0;
+    recorder.header = NULL;
+    recorder.failed = false;
+
+    if (!growFile(sizeof(TrajHeader) + FILE_GROW)) {
+        close(recorder.fd);
+        return false;
+    }
+
+    memcpy(recorder.header->magic, TRAJ_MAGIC, 4);
+    recorder.header->version = TRAJ_VERSION;
+    recorder.header->maxBullets = MAX_BULLETS;
+    recorder.header->blockTicks = BLOCK_TICKS;
+    recorder.header->numBlocks = 0;
+    recorder.header->dataEnd = sizeof(TrajHeader);
+
+    for (int s = 0; s < NUM_SLOTS; s++) {
+        recorder.slotState[s] = SLOT_FREE;
+    }
+
+    recorder.compress = compress;
+    recorder.filling = -1;
+    recorder.queueHead = 0;
+    recorder.queueCount = 0;
+    recorder.stopping = false;
+    recorder.tick = 0;
+    recorder.droppedTicks = 0;
+    recorder.fileBytes = sizeof(TrajHeader);
+    recorder.rawBytes = 0;
+
+    pthread_mutex_init(&recorder.lock, NULL);
+    pthread_cond_init(&recorder.wake, NULL);
+
+    // Without the writer every slot would fill up and every tick after that would be dropped, so don't record at all
+    if (pthread_create(&recorder.thread, NULL, writerThread, NULL) != 0) {
+        TraceLog(LOG_WARNING, "RECORD: could not start the writer thread");
+        pthread_cond_destroy(&recorder.wake);
+        pthread_mutex_destroy(&recorder.lock);
+        munmap(recorder.header, recorder.mappedSize);
+        recorder.header = NULL;
+        close(recorder.fd);
+        unlink(path);
+        return false;
+    }
+
+    recorder.isOpen = true;
+
+    TraceLog(LOG_INFO, "RECORD: writing to %s%s", path, compress ? " (compressed)" : "");
+
+    return true;
+}
+
+// Called once a tick, after update()
+void recordTick(void) {
+    if (!recorder.isOpen) {
+        return;
+    }
+
+    // Grab a free slot if we don't have one
+    if (recorder.filling < 0) {
+        pthread_mutex_lock(&recorder.lock);
+        for (int s = 0; s < NUM_SLOTS; s++) {
+            if (recorder.slotState[s] == SLOT_FREE) {
+                recorder.slotState[s] = SLOT_FILLING;
+                recorder.filling = s;
+                recorder.slots[s].firstTick = recorder.tick;
+                recorder.slots[s].numTicks = 0;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&recorder.lock);
+    }
+
+    // The writer is behind and every slot is taken, so this tick is lost
+    if (recorder.filling < 0) {
+        __atomic_add_fetch(&recorder.droppedTicks, 1, __ATOMIC_RELAXED);
+        recorder.tick++;
+        return;
+    }
+
+    RawBlock *block = &recorder.slots[recorder.filling];
+    int t = block->numTicks;
+
+    memset(block->alive[t], 0, MASK_BYTES);
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            block->alive[t][i / 8] |= 1 << (i % 8);
+        }
+
+        block->x[t][i] = bullets[i].position.x;
+        block->y[t][i] = bullets[i].position.y;
+        block->vx[t][i] = bullets[i].velocity.x;
+        block->vy[t][i] = bullets[i].velocity.y;
+    }
+
+    block->numTicks++;
+    recorder.tick++;
+
+    if (block->numTicks == BLOCK_TICKS) {
+        pthread_mutex_lock(&recorder.lock);
+
+        recorder.slotState[recorder.filling] = SLOT_QUEUED;
+        recorder.queue[(recorder.queueHead + recorder.queueCount) % NUM_SLOTS] = recorder.filling;
+        recorder.queueCount++;
+        recorder.filling = -1;
+
+        pthread_cond_signal(&recorder.wake);
+        pthread_mutex_unlock(&recorder.lock);
+    }
+}
+
+void closeRecorder(void) {
+    if (!recorder.isOpen) {
+        return;
+    }
+
+    pthread_mutex_lock(&recorder.lock);
+
+    // Whatever is half full still gets written
+    if (recorder.filling >= 0 && recorder.slots[recorder.filling].numTicks > 0) {
+        recorder.slotState[recorder.filling] = SLOT_QUEUED;
+        recorder.queue[(recorder.queueHead + recorder.queueCount) % NUM_SLOTS] = recorder.filling;
+        recorder.queueCount++;
+        recorder.filling = -1;
+    }
+
+    recorder.stopping = true;
+    pthread_cond_signal(&recorder.wake);
+    pthread_mutex_unlock(&recorder.lock);
+
+    pthread_join(recorder.thread, NULL);
+
+    // Trim the unused end of the last grow. A failed grow keeps the old mapping, so everything up to dataEnd is still good
+    uint64_t end = 0;
+
+    if (recorder.header != NULL) {
+        end = recorder.header->dataEnd;
+        msync(recorder.header, recorder.mappedSize, MS_SYNC);
+        munmap(recorder.header, recorder.mappedSize);
+        recorder.header = NULL;
+    }
+
+    if (recorder.failed) {
+        TraceLog(LOG_WARNING, "RECORD: the file stopped growing, it only has the blocks up to then");
+    }
+
+    if (ftruncate(recorder.fd, end) != 0) {
+        TraceLog(LOG_WARNING, "RECORD: could not trim file");
+    }
+    close(recorder.fd);
+
+    pthread_mutex_destroy(&recorder.lock);
+    pthread_cond_destroy(&recorder.wake);
+
+    TraceLog(LOG_INFO, "RECORD: %lld ticks, %lld dropped, %.1f MB on disk for %.1f MB raw",
+             (long long) recorder.tick, (long long) recorder.droppedTicks, end / (1024.0 * 1024.0), recorder.rawBytes / (1024.0 * 1024.0));
+
+    recorder.isOpen = false;
+}
+
+void *writerThread(void *arg) {
+    (void) arg;
+
+    uint8_t *encoded = malloc(MAX_ENCODED);
+
+    while (true) {
+        pthread_mutex_lock(&recorder.lock);
+
+        while (recorder.queueCount == 0 && !recorder.stopping) {
+            pthread_cond_wait(&recorder.wake, &recorder.lock);
+        }
+
+        if (recorder.queueCount == 0) {
+            pthread_mutex_unlock(&recorder.lock);
+            break;
+        }
+
+        int slot = recorder.queue[recorder.queueHead];
+        recorder.queueHead = (recorder.queueHead + 1) % NUM_SLOTS;
+        recorder.queueCount--;
+
+        pthread_mutex_unlock(&recorder.lock);
+
+        TrajHeader *header = recorder.header;
+
+        if (recorder.failed) {
+            __atomic_add_fetch(&recorder.droppedTicks, recorder.slots[slot].numTicks, __ATOMIC_RELAXED);
+        }
+        else if (header->numBlocks >= INDEX_CAPACITY) {
+            TraceLog(LOG_WARNING, "RECORD: index is full, dropping block");
+            __atomic_add_fetch(&recorder.droppedTicks, recorder.slots[slot].numTicks, __ATOMIC_RELAXED);
+        }
+        else {
+            int rawSize = encodeBlock(slot, encoded);
+            uint8_t *data = encoded;
+            int storedSize = rawSize;
+            uint32_t flags = 0;
+
+            if (recorder.compress) {
+                int compSize = 0;
+                unsigned char *comp = CompressData(encoded, rawSize, &compSize);
+
+                if (comp != NULL && compSize < rawSize) {
+                    data = comp;
+                    storedSize = compSize;
+                    flags |= BLOCK_COMPRESSED;
+                }
+                else if (comp != NULL) {
+                    MemFree(comp);
+                }
+            }
+
+            if (growFile(header->dataEnd + storedSize)) {
+                header = recorder.header;
+
+                memcpy((uint8_t *) header + header->dataEnd, data, storedSize);
+
+                TrajBlock *entry = &header->index[header->numBlocks];
+                entry->firstTick = recorder.slots[slot].firstTick;
+                entry->offset = header->dataEnd;
+                entry->storedSize = storedSize;
+                entry->rawSize = rawSize;
+                entry->numTicks = recorder.slots[slot].numTicks;
+                entry->flags = flags;
+
+                header->dataEnd += storedSize;
+
+                // Bumped last, so a reader that sees the new count also sees the whole entry
+                __atomic_store_n(&header->numBlocks, header->numBlocks + 1, __ATOMIC_RELEASE);
+
+                __atomic_store_n(&recorder.fileBytes, header->dataEnd, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&recorder.rawBytes, (uint64_t) recorder.slots[slot].numTicks * MAX_BULLETS * sizeof(Bullet), __ATOMIC_RELAXED);
+            }
+            else {
+                TraceLog(LOG_WARNING, "RECORD: could not grow file, not recording any more");
+                __atomic_store_n(&recorder.failed, true, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&recorder.droppedTicks, recorder.slots[slot].numTicks, __ATOMIC_RELAXED);
+            }
+
+            if (data != encoded) {
+                MemFree(data);
+            }
+        }
+
+        pthread_mutex_lock(&recorder.lock);
+        recorder.slotState[slot] = SLOT_FREE;
+        pthread_mutex_unlock(&recorder.lock);
+    }
+
+    free(encoded);
+
+    return NULL;
+}
+
+/*
+Makes sure the mapping covers at least size bytes, growing the file FILE_GROW at a time.
+The new mapping is made before the old one goes, so if anything fails the old one (and everything written to it) is still
+there. Growing the file doesn't touch the pages the old mapping has, and closeRecorder() trims any extra off again.
+*/
+bool growFile(uint64_t size) {
+    if (size <= recorder.mappedSize) {
+        return true;
+    }
+
+    uint64_t newSize = recorder.mappedSize;
+    while (newSize < size) {
+        newSize += FILE_GROW;
+    }
+
+    if (ftruncate(recorder.fd, newSize) != 0) {
+        return false;
+    }
+
+    void *map = mmap(NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, recorder.fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    if (recorder.header != NULL) {
+        munmap(recorder.header, recorder.mappedSize);
+    }
+
+    recorder.header = map;
+    recorder.mappedSize = newSize;
+
+    return true;
+}
+
+// Varints: 7 bits per byte, top bit set means another byte follows. Zigzag puts small negatives next to small positives.
+static uint8_t *putVarint(uint8_t *out, int32_t value) {
+    uint32_t zigzag = ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+
+    while (zigzag >= 0x80) {
+        *out++ = (uint8_t) (zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    *out++ = (uint8_t) zigzag;
+
+    return out;
+}
+
+static const uint8_t *getVarint(const uint8_t *in, const uint8_t *end, int32_t *value) {
+    uint32_t zigzag = 0;
+    int shift = 0;
+
+    while (in < end && shift < 35) {
+        uint8_t byte = *in++;
+        zigzag |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+
+        if (!(byte & 0x80)) {
+            *value = (int32_t) (zigzag >> 1) ^ -(int32_t) (zigzag & 1);
+            return in;
+        }
+    }
+
+    return NULL;
+}
+
+// Returns the encoded size
+int encodeBlock(int slot, uint8_t *out) {
+    RawBlock *block = &recorder.slots[slot];
+    uint8_t *cur = out;
+
+    for (int t = 0; t < block->numTicks; t++) {
+        memcpy(cur, block->alive[t], MASK_BYTES);
+        cur += MASK_BYTES;
+    }
+
+    float (*columns[4])[MAX_BULLETS] = {block->x, block->y, block->vx, block->vy};
+    const float scales[4] = {POS_SCALE, POS_SCALE, VEL_SCALE, VEL_SCALE};
+
+    for (int c = 0; c < 4; c++) {
+        int32_t prev[MAX_BULLETS] = {0};
+
+        for (int t = 0; t < block->numTicks; t++) {
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                if (block->alive[t][i / 8] & (1 << (i % 8))) {
+                    int32_t q = (int32_t) lrintf(columns[c][t][i] * scales[c]);
+                    cur = putVarint(cur, q - prev[i]);
+                    prev[i] = q;
+                }
+            }
+        }
+    }
+
+    return (int) (cur - out);
+}
+
+// Decodes into decoded. Dead bullets come out as 0.
+bool decodeBlock(const uint8_t *in, int size, int numTicks) {
+    const uint8_t *cur = in;
+    const uint8_t *end = in + size;
+
+    // numTicks comes from the file, and decoded only has room for BLOCK_TICKS
+    if (numTicks <= 0 || numTicks > BLOCK_TICKS || size < numTicks * MASK_BYTES) {
+        return false;
+    }
+
+    decoded.numTicks = numTicks;
+
+    for (int t = 0; t < numTicks; t++) {
+        memcpy(decoded.alive[t], cur, MASK_BYTES);
+        cur += MASK_BYTES;
+    }
+
+    float (*columns[4])[MAX_BULLETS] = {decoded.x, decoded.y, decoded.vx, decoded.vy};
+    const float scales[4] = {POS_SCALE, POS_SCALE, VEL_SCALE, VEL_SCALE};
+
+    for (int c = 0; c < 4; c++) {
+        int32_t prev[MAX_BULLETS] = {0};
+
+        for (int t = 0; t < numTicks; t++) {
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                columns[c][t][i] = 0;
+
+                if (decoded.alive[t][i / 8] & (1 << (i % 8))) {
+                    int32_t delta;
+                    cur = getVarint(cur, end, &delta);
+                    if (cur == NULL) {
+                        return false;
+                    }
+
+                    prev[i] += delta;
+                    columns[c][t][i] = prev[i] / scales[c];
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Reader ================================================================
+
+int readRange(const char *path, int64_t first, int64_t last) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "could not open %s\n", path);
+        return 1;
+    }
+
+    struct stat info;
+    fstat(fd, &info);
+
+    if ((uint64_t) info.st_size < sizeof(TrajHeader)) {
+        fprintf(stderr, "%s is too small to be a recording\n", path);
+        close(fd);
+        return 1;
+    }
+
+    const uint8_t *file = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (file == MAP_FAILED) {
+        fprintf(stderr, "could not map %s\n", path);
+        return 1;
+    }
+
+    const TrajHeader *header = (const TrajHeader *) file;
+
+    if (memcmp(header->magic, TRAJ_MAGIC, 4) != 0 || header->version != TRAJ_VERSION || header->maxBullets != MAX_BULLETS) {
+        fprintf(stderr, "%s is not a recording from this version\n", path);
+        munmap((void *) file, info.st_size);
+        return 1;
+    }
+
+    uint64_t numBlocks = __atomic_load_n(&header->numBlocks, __ATOMIC_ACQUIRE);
+
+    if (numBlocks > INDEX_CAPACITY) {
+        fprintf(stderr, "%s says it has %llu blocks, the index only holds %d\n", path, (unsigned long long) numBlocks, INDEX_CAPACITY);
+        munmap((void *) file, info.st_size);
+        return 1;
+    }
+
+    // First block that ends after first
+    uint64_t lo = 0, hi = numBlocks;
+    while (lo < hi) {
+        uint64_t mid = (lo + hi) / 2;
+        if (header->index[mid].firstTick + header->index[mid].numTicks <= first) { lo = mid + 1; }
+        else { hi = mid; }
+    }
+
+    printf("tick,alive,meanX,meanY\n");
+
+    for (uint64_t b = lo; b < numBlocks && header->index[b].firstTick <= last; b++) {
+        const TrajBlock *entry = &header->index[b];
+
+        if (entry->numTicks == 0 || entry->numTicks > BLOCK_TICKS) {
+            fprintf(stderr, "block %llu is corrupt (%u ticks)\n", (unsigned long long) b, entry->numTicks);
+            break;
+        }
+
+        if (entry->offset + entry->storedSize > (uint64_t) info.st_size) {
+            fprintf(stderr, "block %llu runs past the end of the file\n", (unsigned long long) b);
+            break;
+        }
+
+        const uint8_t *data = file + entry->offset;
+        unsigned char *inflated = NULL;
+        int size = entry->storedSize;
+
+        if (entry->flags & BLOCK_COMPRESSED) {
+            inflated = DecompressData((unsigned char *) data, entry->storedSize, &size);
+            data = inflated;
+        }
+
+        if (data == NULL || (uint32_t) size != entry->rawSize || !decodeBlock(data, size, entry->numTicks)) {
+            fprintf(stderr, "block %llu is corrupt\n", (unsigned long long) b);
+            if (inflated != NULL) { MemFree(inflated); }
+            break;
+        }
+
+        for (int t = 0; t < decoded.numTicks; t++) {
+            int64_t tick = entry->firstTick + t;
+            if (tick < first || tick > last) {
+                continue;
+            }
+
+            int alive = 0;
+            double sumX = 0, sumY = 0;
+
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                if (decoded.alive[t][i / 8] & (1 << (i % 8))) {
+                    alive++;
+                    sumX += decoded.x[t][i];
+                    sumY += decoded.y[t][i];
+                }
+            }
+
+            printf("%lld,%d,%.3f,%.3f\n", (long long) tick, alive, alive ? sumX / alive : 0, alive ? sumY / alive : 0);
+        }
+
+        if (inflated != NULL) {
+            MemFree(inflated);
+        }
+    }
+
+    munmap((void *) file, info.st_size);
+
+    return 0;
+}
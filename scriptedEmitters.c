@@ -0,0 +1,350 @@
+/*
+Scripted Emitters - October 2026
+
+An updated version of "borderOfWaveAndParticle.c", but every emitter runs its own little script (coroutine.h)
+instead of all of them sharing one frameCounter % n check in update().
+
+With frameCounter arithmetic, "fire a ring, wait 10 ticks, rotate, repeat 30 times, then stop" turns into a counter,
+a modulo and a state variable per emitter, and a sequence of those turns into a switch (gameState) like bezier_2pts.c.
+As a script it is just the loop:
+
+    for (s->i = 0; s->i < RING_REPEATS; s->i++) {
+        fireRing(...);
+        CO_WAIT(&s->co, tick, RING_WAIT);
+        s->angle += s->spin;
+    }
+
+The whole show is a script too (directorScript), it starts emitters and waits for them to finish, one act after another.
+
+Scheduler:
+    every script lives in one flat array (scripts), a Coroutine + the few variables it keeps across yields, 36 bytes each
+    each tick we walk the array once, a sleeping script costs one compare, an awake one costs one call
+    a script that finishes gets the last script moved into its slot, so the array stays packed and nothing is ever allocated
+
+Controls:
+    UP / DOWN   size of the crowd in act 3 (+- 1000 emitters)
+    SPACE       stop every emitter and skip to the next act
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include "raylib.h"
+#include "coroutine.h"
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define MAX_SCRIPTS 65536
+#define MAX_BULLETS 100000
+#define BULLET_SPEED 2.5f
+
+#define RING_BULLETS 8
+#define RING_WAIT 10
+#define RING_REPEATS 30
+
+#define SPIRAL_ARMS 3
+#define SPIRAL_TICKS 90
+#define SPIRAL_REPEATS 3
+
+#define CROWD_BULLETS 3
+#define CROWD_WAIT 40
+#define CROWD_REPEATS 8
+
+typedef enum ScriptType {
+    SCRIPT_DIRECTOR,
+    SCRIPT_RING,
+    SCRIPT_SPIRAL,
+    SCRIPT_CROWD
+} ScriptType;
+
+typedef struct Script {
+    Coroutine co;
+    int type;
+    Vector2 position;
+    float angle;
+    float spin;
+
+    // Loop counters, these have to live here since locals don't survive a yield
+    int i;
+    int j;
+} Script;
+
+typedef struct Bullet {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+typedef CoStatus (*ScriptFn)(Script *s);
+
+void init(void);
+void update(void);
+void draw(void);
+int startScript(int type, Vector2 position, float angle, float spin, int delay);
+void runScripts(void);
+void stopEmitters(void);
+void fire(Vector2 position, float angle);
+CoStatus directorScript(Script *s);
+CoStatus ringScript(Script *s);
+CoStatus spiralScript(Script *s);
+CoStatus crowdScript(Script *s);
+
+ScriptFn scriptFns[] = {directorScript, ringScript, spiralScript, crowdScript};
+
+Script scripts[MAX_SCRIPTS];
+int numScripts = 0;
+
+Bullet bullets[MAX_BULLETS];
+int curBullet = 0;
+
+int tick = 0;
+int crowdSize = 20000;
+const char *actName = "";
+
+// Stats
+int resumedScripts = 0;
+int peakScripts = 0;
+double scriptMs = 0;
+double bulletMs = 0;
+
+int main() {
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    startScript(SCRIPT_DIRECTOR, (Vector2) {SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2}, 0, 0, 0);
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_UP) && crowdSize + 1000 < MAX_SCRIPTS) { crowdSize += 1000; }
+    if (IsKeyPressed(KEY_DOWN) && crowdSize > 1000) { crowdSize -= 1000; }
+    if (IsKeyPressed(KEY_SPACE)) { stopEmitters(); }
+
+    double start = GetTime();
+    runScripts();
+    scriptMs = (GetTime() - start) * 1000.0;
+
+    if (numScripts > peakScripts) { peakScripts = numScripts; }
+
+    // Update bullets ====================================================
+    start = GetTime();
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!bullets[i].isActive) {
+            continue;
+        }
+
+        bullets[i].position.x += bullets[i].velocity.x;
+        bullets[i].position.y += bullets[i].velocity.y;
+
+        if (bullets[i].position.x < 0 || bullets[i].position.x > SCREEN_WIDTH ||
+            bullets[i].position.y < 0 || bullets[i].position.y > SCREEN_HEIGHT) {
+            bullets[i].isActive = false;
+        }
+    }
+
+    bulletMs = (GetTime() - start) * 1000.0;
+
+    tick++;
+}
+
+void draw(void) {
+    const Color scriptColors[] = {WHITE, YELLOW, SKYBLUE, ORANGE};
+
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].isActive) {
+                DrawRectangle(bullets[i].position.x - 1, bullets[i].position.y - 1, 3, 3, RAYWHITE);
+            }
+        }
+
+        // Only the first few thousand emitters, past that it is just a solid carpet of dots anyway
+        for (int i = 0; i < numScripts && i < 4000; i++) {
+            if (scripts[i].type != SCRIPT_DIRECTOR) {
+                DrawCircleV(scripts[i].position, 3, scriptColors[scripts[i].type]);
+            }
+        }
+
+        DrawRectangle(5, 5, 380, 155, Fade(BLACK, 0.7f));
+        DrawText(actName, 10, 10, 20, WHITE);
+        DrawText(TextFormat("scripts: %d (peak %d)", numScripts, peakScripts), 10, 35, 20, WHITE);
+        DrawText(TextFormat("resumed this tick: %d", resumedScripts), 10, 60, 20, WHITE);
+        DrawText(TextFormat("scripts: %.3f ms  bullets: %.3f ms", scriptMs, bulletMs), 10, 85, 20, WHITE);
+        DrawText(TextFormat("crowd: %d [UP/DOWN]", crowdSize), 10, 110, 20, WHITE);
+        DrawFPS(10, 135);
+
+    EndDrawing();
+}
+
+// Adds a script to the end of the array, delay is how many ticks it sleeps before its first resume
+// Returns its index (only good until the next runScripts), or -1 if we are full
+int startScript(int type, Vector2 position, float angle, float spin, int delay) {
+    if (numScripts >= MAX_SCRIPTS) {
+        return -1;
+    }
+
+    Script *s = &scripts[numScripts];
+
+    CO_INIT(&s->co);
+    s->co.wakeTick = tick + delay;
+    s->type = type;
+    s->position = position;
+    s->angle = angle;
+    s->spin = spin;
+    s->i = 0;
+    s->j = 0;
+
+    return numScripts++;
+}
+
+/*
+One pass over the packed array.
+A finished script is swapped with the last one and k is stepped back, so the script that got moved in still runs this tick.
+Scripts started during the pass land at the end and also run this tick (with delay 0).
+*/
+void runScripts(void) {
+    resumedScripts = 0;
+
+    for (int k = 0; k < numScripts; k++) {
+        if (scripts[k].co.wakeTick > tick) {
+            continue;
+        }
+
+        resumedScripts++;
+
+        if (scriptFns[scripts[k].type](&scripts[k]) == CO_DONE) {
+            scripts[k] = scripts[numScripts - 1];
+            numScripts--;
+            k--;
+        }
+    }
+}
+
+// Kills everything but the director, which then sees numScripts == 1 and moves on
+void stopEmitters(void) {
+    int kept = 0;
+
+    for (int k = 0; k < numScripts; k++) {
+        if (scripts[k].type == SCRIPT_DIRECTOR) {
+            scripts[kept++] = scripts[k];
+        }
+    }
+
+    numScripts = kept;
+}
+
+void fire(Vector2 position, float angle) {
+    bullets[curBullet].isActive = true;
+    bullets[curBullet].position = position;
+    bullets[curBullet].velocity = (Vector2) {cos(angle * DEG2RAD) * BULLET_SPEED, sin(angle * DEG2RAD) * BULLET_SPEED};
+
+    curBullet++;
+    if (curBullet >= MAX_BULLETS) {
+        curBullet = 0;
+    }
+}
+
+// Scripts ===============================================================
+
+CoStatus directorScript(Script *s) {
+    CO_BEGIN(&s->co);
+
+        for (;;) {
+            actName = "act 1: one ring";
+            startScript(SCRIPT_RING, s->position, 0, 7, 0);
+            CO_WAIT_UNTIL(&s->co, numScripts == 1);
+
+            actName = "act 2: spirals";
+            for (s->i = 0; s->i < 8; s->i++) {
+                float a = s->i * 45 * DEG2RAD;
+                startScript(SCRIPT_SPIRAL, (Vector2) {s->position.x + cos(a) * 300, s->position.y + sin(a) * 300},
+                            s->i * 45, (s->i % 2 == 0) ? 4 : -4, 0);
+                CO_WAIT(&s->co, tick, 15);
+            }
+            CO_WAIT_UNTIL(&s->co, numScripts == 1);
+
+            actName = "act 3: the crowd";
+            for (s->i = 0; s->i < crowdSize; s->i++) {
+                // Random start so they don't all fire on the same tick
+                startScript(SCRIPT_CROWD, (Vector2) {GetRandomValue(0, SCREEN_WIDTH), GetRandomValue(0, SCREEN_HEIGHT)},
+                            GetRandomValue(0, 359), GetRandomValue(-20, 20), GetRandomValue(0, CROWD_WAIT));
+            }
+            CO_WAIT_UNTIL(&s->co, numScripts == 1);
+
+            actName = "intermission";
+            CO_WAIT(&s->co, tick, 60);
+        }
+
+    CO_END(&s->co);
+}
+
+// Fire a ring, wait, rotate, repeat
+CoStatus ringScript(Script *s) {
+    CO_BEGIN(&s->co);
+
+        for (s->i = 0; s->i < RING_REPEATS; s->i++) {
+            for (int b = 0; b < RING_BULLETS; b++) {
+                fire(s->position, s->angle + b * (360.0f / RING_BULLETS));
+            }
+
+            CO_WAIT(&s->co, tick, RING_WAIT);
+            s->angle += s->spin;
+        }
+
+    CO_END(&s->co);
+}
+
+// SPIRAL_ARMS bullets every tick while turning, then a break, a few times over
+CoStatus spiralScript(Script *s) {
+    CO_BEGIN(&s->co);
+
+        for (s->j = 0; s->j < SPIRAL_REPEATS; s->j++) {
+            for (s->i = 0; s->i < SPIRAL_TICKS; s->i++) {
+                for (int b = 0; b < SPIRAL_ARMS; b++) {
+                    fire(s->position, s->angle + b * (360.0f / SPIRAL_ARMS));
+                }
+
+                s->angle += s->spin;
+                CO_YIELD(&s->co);
+            }
+
+            CO_WAIT(&s->co, tick, 30);
+            s->spin = -s->spin;
+        }
+
+    CO_END(&s->co);
+}
+
+// Same as a ring but smaller, there are tens of thousands of these
+CoStatus crowdScript(Script *s) {
+    CO_BEGIN(&s->co);
+
+        for (s->i = 0; s->i < CROWD_REPEATS; s->i++) {
+            for (int b = 0; b < CROWD_BULLETS; b++) {
+                fire(s->position, s->angle + b * (360.0f / CROWD_BULLETS));
+            }
+
+            CO_WAIT(&s->co, tick, CROWD_WAIT);
+            s->angle += s->spin;
+        }
+
+    CO_END(&s->co);
+}
@@ -0,0 +1,286 @@
+/*
+Scrolling World - October 2026
+
+An updated version of "borderOfWaveAndParticle.c", on a world WORLD_CHUNKS_X x WORLD_CHUNKS_Y chunks big (about 5 x 6 screens)
+with an emitter in the middle of every chunk and a Camera2D you scroll around.
+
+Every bullet flies in a straight line, so instead of stepping it we keep where and when it was fired:
+    position(tick) = origin + velocity * (tick - spawnTick)
+which means a bullet can be brought up to any tick in one go, it doesn't matter if we skipped it for a while.
+Same for the emitters, their angle is just deltaRAngle * tick, so the shots a chunk missed can be fired late with the tick
+they should have been fired on, and they end up exactly where they would have been.
+
+The world is cut into chunks, each with its own list of bullets
+    near chunks (the ones on screen + a ring of NEAR_MARGIN around them) update every tick
+    far chunks update every FAR_INTERVAL ticks, staggered so only 1 / FAR_INTERVAL of them do it on any one tick
+A chunk that turns near is caught up right away, so it is already in sync on the first frame you can see it.
+A chunk that turns far just stops updating every tick. Far chunks still update now and then so their bullets can move
+into other chunks (and into view) and so old bullets get removed before the chunk fills up.
+
+Controls:
+    WASD / arrows   scroll
+    L               LOD on / off (off = every chunk updates every tick, to compare the timings)
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+void updateChunk(int chunk, int now);
+void fireShots(int chunk, int spawnTick);
+bool addBullet(int chunk, Vector2 origin, Vector2 velocity, int spawnTick);
+int chunkAt(Vector2 position);
+
+#define SCREEN_WIDTH 1280
+#define SCREEN_HEIGHT 720
+
+#define CHUNK_SIZE 512
+#define WORLD_CHUNKS_X 12
+#define WORLD_CHUNKS_Y 8
+#define NUM_CHUNKS (WORLD_CHUNKS_X * WORLD_CHUNKS_Y)
+#define WORLD_WIDTH (CHUNK_SIZE * WORLD_CHUNKS_X)
+#define WORLD_HEIGHT (CHUNK_SIZE * WORLD_CHUNKS_Y)
+#define CHUNK_BULLETS 2048
+
+#define NEAR_MARGIN 1
+#define FAR_INTERVAL 16
+
+#define NUM_TARGETS 5
+#define FIRE_INTERVAL 4
+#define MAX_VELOCITY 5
+#define BULLET_LIFETIME 600
+#define SCROLL_SPEED 12
+
+typedef struct Bullet {
+    Vector2 origin;
+    Vector2 velocity;
+    Vector2 position;
+    int spawnTick;
+} Bullet;
+
+// Bullets are stored by the chunk they are in, so a chunk update only ever touches its own bullets
+Bullet chunkBullets[NUM_CHUNKS][CHUNK_BULLETS];
+int chunkCount[NUM_CHUNKS];
+
+// The last tick the chunk was brought up to
+int chunkTick[NUM_CHUNKS];
+bool chunkNear[NUM_CHUNKS];
+
+Camera2D camera;
+
+float deltaRAngle = 0.225f;
+int tick = 0;
+bool useLod = true;
+
+// Stats
+int nearChunks = 0;
+int bulletsUpdated = 0;
+int totalBullets = 0;
+int droppedBullets = 0;
+double updateMs = 0;
+
+int main() {
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    camera.target = (Vector2) {WORLD_WIDTH / 2, WORLD_HEIGHT / 2};
+    camera.offset = (Vector2) {SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2};
+    camera.rotation = 0;
+    camera.zoom = 1;
+
+    for (int c = 0; c < NUM_CHUNKS; c++) {
+        chunkCount[c] = 0;
+        chunkTick[c] = 0;
+        chunkNear[c] = false;
+    }
+}
+
+void update(void) {
+
+    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) { camera.target.x -= SCROLL_SPEED; }
+    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) { camera.target.x += SCROLL_SPEED; }
+    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) { camera.target.y -= SCROLL_SPEED; }
+    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) { camera.target.y += SCROLL_SPEED; }
+    if (IsKeyPressed(KEY_L)) { useLod = !useLod; }
+
+    // Keep the view inside the world
+    if (camera.target.x < SCREEN_WIDTH / 2) { camera.target.x = SCREEN_WIDTH / 2; }
+    if (camera.target.x > WORLD_WIDTH - SCREEN_WIDTH / 2) { camera.target.x = WORLD_WIDTH - SCREEN_WIDTH / 2; }
+    if (camera.target.y < SCREEN_HEIGHT / 2) { camera.target.y = SCREEN_HEIGHT / 2; }
+    if (camera.target.y > WORLD_HEIGHT - SCREEN_HEIGHT / 2) { camera.target.y = WORLD_HEIGHT - SCREEN_HEIGHT / 2; }
+
+    tick++;
+
+    // Which chunks are near this tick
+    int x0 = (camera.target.x - SCREEN_WIDTH / 2) / CHUNK_SIZE - NEAR_MARGIN;
+    int y0 = (camera.target.y - SCREEN_HEIGHT / 2) / CHUNK_SIZE - NEAR_MARGIN;
+    int x1 = (camera.target.x + SCREEN_WIDTH / 2) / CHUNK_SIZE + NEAR_MARGIN;
+    int y1 = (camera.target.y + SCREEN_HEIGHT / 2) / CHUNK_SIZE + NEAR_MARGIN;
+
+    double start = GetTime();
+
+    nearChunks = 0;
+    bulletsUpdated = 0;
+
+    for (int c = 0; c < NUM_CHUNKS; c++) {
+        int cx = c % WORLD_CHUNKS_X;
+        int cy = c / WORLD_CHUNKS_X;
+
+        chunkNear[c] = !useLod || (cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1);
+
+        if (chunkNear[c]) {
+            nearChunks++;
+        }
+
+        // Near chunks every tick (one that just turned near catches up here too), far ones on their turn
+        if (chunkNear[c] || (tick + c) % FAR_INTERVAL == 0) {
+            updateChunk(c, tick);
+        }
+    }
+
+    updateMs = (GetTime() - start) * 1000.0;
+
+    totalBullets = 0;
+    for (int c = 0; c < NUM_CHUNKS; c++) {
+        totalBullets += chunkCount[c];
+    }
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        BeginMode2D(camera);
+
+            for (int c = 0; c < NUM_CHUNKS; c++) {
+                int cx = c % WORLD_CHUNKS_X;
+                int cy = c / WORLD_CHUNKS_X;
+
+                DrawRectangleLines(cx * CHUNK_SIZE, cy * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE, chunkNear[c] ? DARKGREEN : DARKGRAY);
+                DrawCircle(cx * CHUNK_SIZE + CHUNK_SIZE / 2, cy * CHUNK_SIZE + CHUNK_SIZE / 2, 5, YELLOW);
+
+                // Far chunks are never on screen, and their positions are a few ticks old anyway
+                if (!chunkNear[c]) {
+                    continue;
+                }
+
+                for (int i = 0; i < chunkCount[c]; i++) {
+                    DrawCircleV(chunkBullets[c][i].position, 3, PURPLE);
+                }
+            }
+
+        EndMode2D();
+
+        DrawRectangle(5, 5, 430, 130, Fade(BLACK, 0.7f));
+        DrawText(TextFormat("LOD %s [L], %d / %d chunks near", useLod ? "on" : "off", nearChunks, NUM_CHUNKS), 10, 10, 20, WHITE);
+        DrawText(TextFormat("updated %d of %d bullets", bulletsUpdated, totalBullets), 10, 35, 20, WHITE);
+        DrawText(TextFormat("update: %.3f ms, dropped %d", updateMs, droppedBullets), 10, 60, 20, WHITE);
+        DrawText(TextFormat("camera: %.0f, %.0f", camera.target.x, camera.target.y), 10, 85, 20, WHITE);
+        DrawFPS(10, 110);
+
+    EndDrawing();
+}
+
+/*
+Brings a chunk from chunkTick[chunk] up to now.
+First it fires every shot it missed (with the tick it should have been fired on), then moves every bullet to where it
+is at now. A bullet that has left the chunk is handed to the chunk it is in now, even if that one already updated this
+tick, since updating a bullet twice for the same tick gives the same answer.
+*/
+void updateChunk(int chunk, int now) {
+    for (int t = chunkTick[chunk] + 1; t <= now; t++) {
+        if (t % FIRE_INTERVAL == 0) {
+            fireShots(chunk, t);
+        }
+    }
+
+    chunkTick[chunk] = now;
+
+    Bullet *list = chunkBullets[chunk];
+
+    for (int i = 0; i < chunkCount[chunk]; i++) {
+        int age = now - list[i].spawnTick;
+
+        list[i].position.x = list[i].origin.x + list[i].velocity.x * age;
+        list[i].position.y = list[i].origin.y + list[i].velocity.y * age;
+
+        bulletsUpdated++;
+
+        int dest = chunkAt(list[i].position);
+
+        if (age > BULLET_LIFETIME || dest < 0) {
+            list[i] = list[--chunkCount[chunk]];
+            i--;
+            continue;
+        }
+
+        if (dest != chunk) {
+            if (addBullet(dest, list[i].origin, list[i].velocity, list[i].spawnTick)) {
+                chunkBullets[dest][chunkCount[dest] - 1].position = list[i].position;
+            }
+
+            list[i] = list[--chunkCount[chunk]];
+            i--;
+        }
+    }
+}
+
+// One round of shots from the emitter in the middle of chunk, the way it would have gone out on spawnTick
+void fireShots(int chunk, int spawnTick) {
+    Vector2 centre = (Vector2) {(chunk % WORLD_CHUNKS_X) * CHUNK_SIZE + CHUNK_SIZE / 2,
+                                (chunk / WORLD_CHUNKS_X) * CHUNK_SIZE + CHUNK_SIZE / 2};
+
+    // Every other chunk turns the other way, so neighbours don't look the same
+    float rotation = deltaRAngle * spawnTick * ((chunk % 2 == 0) ? 1 : -1);
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float angle = (rotation + i * (360.0f / NUM_TARGETS)) * DEG2RAD;
+
+        addBullet(chunk, centre, (Vector2) {cos(angle) * MAX_VELOCITY, sin(angle) * MAX_VELOCITY}, spawnTick);
+    }
+}
+
+bool addBullet(int chunk, Vector2 origin, Vector2 velocity, int spawnTick) {
+    if (chunkCount[chunk] >= CHUNK_BULLETS) {
+        droppedBullets++;
+        return false;
+    }
+
+    Bullet *b = &chunkBullets[chunk][chunkCount[chunk]++];
+
+    b->origin = origin;
+    b->velocity = velocity;
+    b->position = origin;
+    b->spawnTick = spawnTick;
+
+    return true;
+}
+
+// -1 outside the world
+int chunkAt(Vector2 position) {
+    if (position.x < 0 || position.x >= WORLD_WIDTH || position.y < 0 || position.y >= WORLD_HEIGHT) {
+        return -1;
+    }
+
+    return ((int) position.y / CHUNK_SIZE) * WORLD_CHUNKS_X + ((int) position.x / CHUNK_SIZE);
+}
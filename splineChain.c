@@ -0,0 +1,478 @@
+/*
+    Spline chain - one long path made of NUM_SEGMENTS joined segments you can drag the points of
+
+    bezier_2pts.c throws the whole curve away and traces it again whenever a point changes, which is fine for one segment
+    but a path of a thousand segments would be redone every frame you drag anything
+
+    so every segment keeps its own cache, worked out from its points:
+        - the flattened polyline (SEGMENT_STEPS + 1 points)
+        - an arc length table, the distance along the segment at every polyline point
+        - its length and bounding box
+    moving a point only marks the segments that use it as dirty (2 for a bezier point, 4 for a catmull-rom one) and puts them
+    on the dirty list, nothing is worked out yet. The first time something needs the chain (drawing, or a runner looking up
+    where it is) cleanChain() redoes just the segments on the list, so dragging a point costs a few segments, not the path
+
+    the lengths before every segment are kept in a fenwick tree (segmentSums), so when one segment changes length only
+    log2(NUM_SEGMENTS) sums change instead of every one after it, and "which segment is s along the whole path" is one walk
+    down the tree, then a binary search in that segment's arc length table
+
+    two kinds of chain, C switches between them:
+        bezier          segment i uses points 2i (start), 2i + 1 (control), 2i + 2 (end), same as targetPts in bezier_2pts.c
+        catmull-rom     segment i goes from point i + 1 to point i + 2 and uses points i to i + 3
+
+    Controls:
+        left drag a point   move it
+        C                   bezier / catmull-rom
+        F                   full rebuild on every edit (what bezier_2pts.c does), to compare the timings
+        UP / DOWN           runner speed
+*/
+
+#include <math.h>
+#include <stdbool.h>
+
+#include "raylib.h"
+
+#define NUM_SEGMENTS 1000
+#define MAX_POINTS (NUM_SEGMENTS * 2 + 3)
+#define SEGMENT_STEPS 16
+#define NUM_RUNNERS 16
+#define PICK_RADIUS 6
+
+void initialize(void);
+void update(void);
+void draw(void);
+
+void resetChain(void);
+void movePoint(int point, Vector2 position);
+void markSegment(int segment);
+void cleanChain(void);
+void rebuildChain(void);
+void flattenSegment(int segment);
+Vector2 evalSegment(int segment, float t);
+void sumsAdd(int segment, double delta);
+double lengthBefore(int segment);
+Vector2 pointAtDistance(double distance);
+int nearestPoint(Vector2 position, float maxDistance);
+
+const int screenWidth = 1280;
+const int screenHeight = 720;
+
+typedef enum ChainType {
+    BEZIER,
+    CATMULL_ROM
+} ChainType;
+
+typedef struct Segment {
+    Vector2 flat[SEGMENT_STEPS + 1];
+    float arcLength[SEGMENT_STEPS + 1];
+    float length;
+    Rectangle bounds;
+    bool dirty;
+} Segment;
+
+ChainType chainType = BEZIER;
+
+Vector2 points[MAX_POINTS];
+int numPoints = 0;
+
+Segment segments[NUM_SEGMENTS];
+
+// Segments waiting for cleanChain(), each one is only on here once (that's what dirty is for)
+int dirtyList[NUM_SEGMENTS];
+int numDirty = 0;
+
+// Fenwick tree over the segment lengths, 1 based. Doubles, since it gets += a delta on every edit and floats would drift
+double segmentSums[NUM_SEGMENTS + 1];
+double totalLength = 0;
+
+bool fullRebuild = false;
+int dragPt = -1;
+int hoverPt = -1;
+
+float runnerSpeed = 4;
+double runnerDistance = 0;
+
+// Stats for the HUD
+double editMicros = 0;
+double cleanMicros = 0;
+int segmentsCleaned = 0;
+int segmentsDrawn = 0;
+
+int main(void)
+{
+    initialize();
+
+    while (!WindowShouldClose())
+    {
+        update();
+
+        draw();
+    }
+
+    CloseWindow();
+
+    return 0;
+}
+
+void initialize(void) {
+    InitWindow(screenWidth, screenHeight, "raylib");
+    SetTargetFPS(60);
+
+    resetChain();
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_C)) {
+        chainType = (chainType == BEZIER) ? CATMULL_ROM : BEZIER;
+        resetChain();
+    }
+    if (IsKeyPressed(KEY_F)) { fullRebuild = !fullRebuild; }
+    if (IsKeyPressed(KEY_UP)) { runnerSpeed *= 2; }
+    if (IsKeyPressed(KEY_DOWN)) { runnerSpeed /= 2; }
+
+    Vector2 mouse = GetMousePosition();
+
+    if (dragPt < 0) {
+        hoverPt = nearestPoint(mouse, PICK_RADIUS);
+
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && hoverPt >= 0) {
+            dragPt = hoverPt;
+        }
+    }
+    else {
+        Vector2 delta = GetMouseDelta();
+
+        if (delta.x != 0 || delta.y != 0) {
+            double start = GetTime();
+
+            movePoint(dragPt, (Vector2) {points[dragPt].x + delta.x, points[dragPt].y + delta.y});
+
+            // The old way, everything from scratch whatever moved
+            if (fullRebuild) {
+                rebuildChain();
+            }
+
+            editMicros = (GetTime() - start) * 1000000.0;
+        }
+
+        if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+            dragPt = -1;
+        }
+    }
+
+    // The runners need real lengths, so this is where the dirty segments get redone
+    double start = GetTime();
+    segmentsCleaned = numDirty;
+    cleanChain();
+    cleanMicros = (GetTime() - start) * 1000000.0;
+
+    runnerDistance += runnerSpeed;
+    if (runnerDistance >= totalLength) {
+        runnerDistance -= totalLength;
+    }
+}
+
+void draw(void) {
+    BeginDrawing();
+
+        ClearBackground(RAYWHITE);
+
+        Rectangle screen = (Rectangle) {0, 0, screenWidth, screenHeight};
+
+        segmentsDrawn = 0;
+
+        for (int s = 0; s < NUM_SEGMENTS; s++) {
+            // Off screen, don't bother
+            if (!CheckCollisionRecs(segments[s].bounds, screen)) {
+                continue;
+            }
+
+            DrawLineStrip(segments[s].flat, SEGMENT_STEPS + 1, (s % 2 == 0) ? BLACK : DARKGRAY);
+            segmentsDrawn++;
+        }
+
+        // Only the points near the mouse, there are a couple of thousand of them
+        for (int p = 0; p < numPoints; p++) {
+            if (fabsf(points[p].x - GetMouseX()) < 60 && fabsf(points[p].y - GetMouseY()) < 60) {
+                DrawCircleV(points[p], 3, (chainType == BEZIER && p % 2 == 1) ? BLUE : GREEN);
+            }
+        }
+
+        if (hoverPt >= 0) {
+            DrawCircleLines(points[hoverPt].x, points[hoverPt].y, PICK_RADIUS, RED);
+        }
+
+        // Evenly spaced along the whole path, however long or short the segments under them are
+        for (int r = 0; r < NUM_RUNNERS; r++) {
+            double distance = fmod(runnerDistance + (totalLength * r) / NUM_RUNNERS, totalLength);
+            DrawCircleV(pointAtDistance(distance), 6, PURPLE);
+        }
+
+        DrawRectangle(5, 5, 520, 105, Fade(RAYWHITE, 0.8f));
+        DrawText(TextFormat("%s, %d segments, %.0f px long", (chainType == BEZIER) ? "bezier" : "catmull-rom", NUM_SEGMENTS, totalLength), 10, 10, 20, BLACK);
+        DrawText(TextFormat("%s [F]: edit %.1f us, clean %.1f us (%d segments)", fullRebuild ? "full rebuild" : "incremental",
+                            editMicros, cleanMicros, segmentsCleaned), 10, 35, 20, BLACK);
+
+        if (dragPt >= 0) {
+            int segment = (chainType == BEZIER) ? dragPt / 2 : dragPt - 1;
+            if (segment < 0) { segment = 0; }
+            if (segment > NUM_SEGMENTS - 1) { segment = NUM_SEGMENTS - 1; }
+
+            DrawText(TextFormat("%d segments on screen, dragging segment %d (%.0f px in)", segmentsDrawn, segment, lengthBefore(segment)), 10, 60, 20, BLACK);
+        }
+        else {
+            DrawText(TextFormat("%d segments on screen", segmentsDrawn), 10, 60, 20, BLACK);
+        }
+        DrawFPS(10, 85);
+
+    EndDrawing();
+}
+
+// A spiral out from the middle, so the path is long but still all on screen
+void resetChain(void) {
+    int numAnchors = (chainType == BEZIER) ? NUM_SEGMENTS + 1 : NUM_SEGMENTS + 3;
+
+    for (int k = 0; k < numAnchors; k++) {
+        float angle = k * 0.1f;
+        float radius = 20 + angle * 3.2f;
+        Vector2 anchor = (Vector2) {screenWidth / 2 + radius * cosf(angle), screenHeight / 2 + radius * sinf(angle)};
+
+        if (chainType == BEZIER) {
+            points[k * 2] = anchor;
+
+            // The control point goes halfway to the next anchor, pushed out a bit so the segment actually bends
+            if (k < NUM_SEGMENTS) {
+                float middle = angle + 0.05f;
+                float bulge = radius + 6 * ((k % 2 == 0) ? 1 : -1);
+                points[k * 2 + 1] = (Vector2) {screenWidth / 2 + bulge * cosf(middle), screenHeight / 2 + bulge * sinf(middle)};
+            }
+        }
+        else {
+            points[k] = anchor;
+        }
+    }
+
+    numPoints = (chainType == BEZIER) ? NUM_SEGMENTS * 2 + 1 : NUM_SEGMENTS + 3;
+    dragPt = -1;
+    hoverPt = -1;
+    runnerDistance = 0;
+
+    rebuildChain();
+}
+
+// Moves a point and marks every segment that uses it, nothing gets worked out until cleanChain()
+void movePoint(int point, Vector2 position) {
+    points[point] = position;
+
+    int first;
+    int last;
+
+    if (chainType == BEZIER) {
+        // An end point is shared with the next segment, a control point isn't
+        first = (point - 1) / 2;
+        last = point / 2;
+    }
+    else {
+        first = point - 3;
+        last = point;
+    }
+
+    if (first < 0) { first = 0; }
+    if (last > NUM_SEGMENTS - 1) { last = NUM_SEGMENTS - 1; }
+
+    for (int s = first; s <= last; s++) {
+        markSegment(s);
+    }
+}
+
+void markSegment(int segment) {
+    if (segments[segment].dirty) {
+        return;
+    }
+
+    segments[segment].dirty = true;
+    dirtyList[numDirty++] = segment;
+}
+
+// Redoes only the segments on the dirty list, and moves the length sums by however much each one changed
+void cleanChain(void) {
+    for (int d = 0; d < numDirty; d++) {
+        int s = dirtyList[d];
+        float oldLength = segments[s].length;
+
+        flattenSegment(s);
+
+        sumsAdd(s, segments[s].length - oldLength);
+        totalLength += segments[s].length - oldLength;
+    }
+
+    numDirty = 0;
+}
+
+// Every segment and every sum from scratch
+void rebuildChain(void) {
+    totalLength = 0;
+
+    for (int s = 0; s < NUM_SEGMENTS; s++) {
+        flattenSegment(s);
+        segmentSums[s + 1] = segments[s].length;
+        totalLength += segments[s].length;
+    }
+
+    segmentSums[0] = 0;
+
+    // Building a fenwick tree in place: every node hands its sum up to its parent
+    for (int i = 1; i <= NUM_SEGMENTS; i++) {
+        int parent = i + (i & -i);
+
+        if (parent <= NUM_SEGMENTS) {
+            segmentSums[parent] += segmentSums[i];
+        }
+    }
+
+    numDirty = 0;
+}
+
+void flattenSegment(int segment) {
+    Segment *seg = &segments[segment];
+
+    float minX = INFINITY;
+    float minY = INFINITY;
+    float maxX = -INFINITY;
+    float maxY = -INFINITY;
+
+    for (int i = 0; i <= SEGMENT_STEPS; i++) {
+        Vector2 p = evalSegment(segment, (float) i / SEGMENT_STEPS);
+        seg->flat[i] = p;
+
+        if (i == 0) {
+            seg->arcLength[i] = 0;
+        }
+        else {
+            float dx = p.x - seg->flat[i - 1].x;
+            float dy = p.y - seg->flat[i - 1].y;
+            seg->arcLength[i] = seg->arcLength[i - 1] + sqrtf(dx * dx + dy * dy);
+        }
+
+        if (p.x < minX) { minX = p.x; }
+        if (p.y < minY) { minY = p.y; }
+        if (p.x > maxX) { maxX = p.x; }
+        if (p.y > maxY) { maxY = p.y; }
+    }
+
+    seg->length = seg->arcLength[SEGMENT_STEPS];
+    seg->bounds = (Rectangle) {minX, minY, maxX - minX, maxY - minY};
+    seg->dirty = false;
+}
+
+Vector2 evalSegment(int segment, float t) {
+    float u = 1 - t;
+
+    if (chainType == BEZIER) {
+        Vector2 p0 = points[segment * 2];
+        Vector2 p1 = points[segment * 2 + 1];
+        Vector2 p2 = points[segment * 2 + 2];
+
+        return (Vector2) {u * u * p0.x + 2 * u * t * p1.x + t * t * p2.x,
+                          u * u * p0.y + 2 * u * t * p1.y + t * t * p2.y};
+    }
+
+    // Uniform catmull-rom, goes through p1 at t = 0 and p2 at t = 1
+    Vector2 p0 = points[segment];
+    Vector2 p1 = points[segment + 1];
+    Vector2 p2 = points[segment + 2];
+    Vector2 p3 = points[segment + 3];
+
+    float t2 = t * t;
+    float t3 = t2 * t;
+
+    return (Vector2) {0.5f * ((2 * p1.x) + (p2.x - p0.x) * t + (2 * p0.x - 5 * p1.x + 4 * p2.x - p3.x) * t2 + (3 * p1.x - p0.x - 3 * p2.x + p3.x) * t3),
+                      0.5f * ((2 * p1.y) + (p2.y - p0.y) * t + (2 * p0.y - 5 * p1.y + 4 * p2.y - p3.y) * t2 + (3 * p1.y - p0.y - 3 * p2.y + p3.y) * t3)};
+}
+
+void sumsAdd(int segment, double delta) {
+    for (int i = segment + 1; i <= NUM_SEGMENTS; i += i & -i) {
+        segmentSums[i] += delta;
+    }
+}
+
+// Length of the path up to the start of segment
+double lengthBefore(int segment) {
+    double sum = 0;
+
+    for (int i = segment; i > 0; i -= i & -i) {
+        sum += segmentSums[i];
+    }
+
+    return sum;
+}
+
+/*
+Where the path is at distance along it.
+The walk down the fenwick tree finds the last segment that starts at or before distance, taking off the lengths it skips,
+then a binary search in that segment's arc length table finds the two polyline points either side.
+*/
+Vector2 pointAtDistance(double distance) {
+    int segment = 0;
+    int step = 1;
+
+    while (step * 2 <= NUM_SEGMENTS) {
+        step *= 2;
+    }
+
+    for (; step > 0; step /= 2) {
+        if (segment + step <= NUM_SEGMENTS && segmentSums[segment + step] <= distance) {
+            segment += step;
+            distance -= segmentSums[segment];
+        }
+    }
+
+    // Past the end (rounding), stay on the last segment
+    if (segment >= NUM_SEGMENTS) {
+        segment = NUM_SEGMENTS - 1;
+        distance = segments[segment].length;
+    }
+
+    Segment *seg = &segments[segment];
+
+    int low = 0;
+    int high = SEGMENT_STEPS;
+
+    while (high - low > 1) {
+        int middle = (low + high) / 2;
+
+        if (seg->arcLength[middle] <= distance) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    float span = seg->arcLength[high] - seg->arcLength[low];
+    float t = (span > 0) ? (distance - seg->arcLength[low]) / span : 0;
+    if (t > 1) { t = 1; }
+
+    return (Vector2) {seg->flat[low].x + (seg->flat[high].x - seg->flat[low].x) * t,
+                      seg->flat[low].y + (seg->flat[high].y - seg->flat[low].y) * t};
+}
+
+// Only when nothing is being dragged, and a couple of thousand points is quick enough to just go through
+int nearestPoint(Vector2 position, float maxDistance) {
+    int best = -1;
+    float bestDistance = maxDistance * maxDistance;
+
+    for (int p = 0; p < numPoints; p++) {
+        float dx = points[p].x - position.x;
+        float dy = points[p].y - position.y;
+        float distance = dx * dx + dy * dy;
+
+        if (distance <= bestDistance) {
+            best = p;
+            bestDistance = distance;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,367 @@
+/*
+Threaded Wave - October 2026
+
+An updated version of "borderOfWaveAndParticle.c" where the simulation runs on its own thread.
+
+In every other demo update() and draw() run back to back, so the frame takes update + draw, and a slow draw holds up the
+next tick (and the other way round). Here the sim thread ticks at TICK_RATE on its own and, after every tick, copies
+what draw() needs (bullet positions, emitter positions, the score) into a Snapshot and publishes it.
+The main thread only ever draws the newest finished snapshot, so a frame takes max(update, draw) instead.
+
+The handoff is a triple buffer, no locks:
+    back    the snapshot the sim thread is writing, only it touches it
+    front   the snapshot the main thread is drawing, only it touches it
+    middle  the spare one, held in an atomic int together with a "fresh" bit
+Publishing swaps back with middle and sets the fresh bit, taking a new snapshot swaps front with middle if the bit is set.
+Both are a single atomic exchange, so neither side ever waits for the other, and a snapshot is never written while it is
+being drawn. If the sim publishes twice before a frame the older one is just overwritten (counted as skipped).
+
+The sim never reads anything the main thread writes except the two atomic flags below, and raylib is only ever called
+from the main thread (input included), since it isn't thread safe.
+
+Controls:
+    T   threaded on / off (off = tick and draw on the main thread like the other demos, to compare)
+    U   add UPDATE_LOAD_MS of busy work to every tick
+    R   add DRAW_LOAD_MS of busy work to every frame
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "raylib.h"
+
+void init(void);
+void update(void);
+void draw(void);
+void *simThread(void *arg);
+void simTick(void);
+void publishSnapshot(double tickMs);
+void startSim(void);
+void stopSim(void);
+void setTargets(void);
+void spinFor(double ms);
+double wallTime(void);
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define NUM_TARGETS 24
+#define MAX_BULLETS 8192
+#define MAX_VELOCITY 5
+
+#define TICK_RATE 60
+#define MAX_CATCHUP 8
+
+#define UPDATE_LOAD_MS 12
+#define DRAW_LOAD_MS 12
+
+// The low 2 bits of middle are the buffer index, FRESH_BIT says the sim put it there and the main thread hasn't taken it yet
+#define FRESH_BIT 4
+#define INDEX_MASK 3
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+// Everything draw() needs from one tick, and nothing it doesn't
+typedef struct {
+    int tick;
+    double publishTime;
+    double tickMs;
+    int numBullets;
+    Vector2 bullets[MAX_BULLETS];
+    Vector2 targets[NUM_TARGETS];
+    int fired;
+    int escaped;
+} Snapshot;
+
+// Sim state, owned by whoever is ticking (the sim thread, or the main thread with threading off)
+Vector2 targets[NUM_TARGETS];
+Bullet bullets[MAX_BULLETS];
+int curBullet;
+float rotationAngle = 0;
+float deltaRAngle = 0.225f;
+int tick = 0;
+int fired = 0;
+int escaped = 0;
+
+Snapshot snapshots[3];
+int back = 0;
+int front = 1;
+atomic_int middle = 2;
+
+// The sim thread's only inputs
+atomic_bool simRunning = false;
+atomic_bool updateLoad = false;
+
+pthread_t simThreadId;
+bool threaded = true;
+bool drawLoad = false;
+
+// Main thread stats
+int lastDrawnTick = 0;
+int skippedSnapshots = 0;
+double drawMs = 0;
+double snapshotAgeMs = 0;
+
+int main() {
+
+    init();
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        update();
+        draw();
+    }
+
+    stopSim();
+    CloseWindow();
+
+    return 0;
+}
+
+void init(void) {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib");
+    SetTargetFPS(60);
+
+    setTargets();
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        bullets[i].isActive = false;
+    }
+
+    startSim();
+}
+
+void update(void) {
+
+    if (IsKeyPressed(KEY_U)) { atomic_store(&updateLoad, !atomic_load(&updateLoad)); }
+    if (IsKeyPressed(KEY_R)) { drawLoad = !drawLoad; }
+
+    if (IsKeyPressed(KEY_T)) {
+        threaded = !threaded;
+
+        // The thread is stopped before the main thread ticks, so the sim state only ever has one owner
+        if (threaded) {
+            startSim();
+        }
+        else {
+            stopSim();
+        }
+    }
+
+    // Threading off: the old way, one tick then draw
+    if (!threaded) {
+        double start = wallTime();
+        simTick();
+        publishSnapshot((wallTime() - start) * 1000.0);
+    }
+
+    // Take the newest snapshot, if there is one we haven't drawn
+    if (atomic_load(&middle) & FRESH_BIT) {
+        front = atomic_exchange(&middle, front) & INDEX_MASK;
+    }
+
+    Snapshot *snap = &snapshots[front];
+
+    if (snap->tick > lastDrawnTick + 1) {
+        skippedSnapshots += snap->tick - lastDrawnTick - 1;
+    }
+    lastDrawnTick = snap->tick;
+}
+
+void draw(void) {
+    double start = wallTime();
+
+    Snapshot *snap = &snapshots[front];
+
+    BeginDrawing();
+
+        ClearBackground(BLACK);
+
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            DrawCircle(snap->targets[i].x + SCREEN_WIDTH / 2, snap->targets[i].y + SCREEN_HEIGHT / 2, 5, YELLOW);
+        }
+
+        for (int i = 0; i < snap->numBullets; i++) {
+            DrawCircleV((Vector2) {snap->bullets[i].x + SCREEN_WIDTH / 2, snap->bullets[i].y + SCREEN_HEIGHT / 2}, 5, PURPLE);
+        }
+
+        if (drawLoad) {
+            spinFor(DRAW_LOAD_MS);
+        }
+
+        // Age is from when the sim finished the tick to now, so it includes however long the frame waited for it
+        snapshotAgeMs = (wallTime() - snap->publishTime) * 1000.0;
+
+        DrawRectangle(5, 5, 470, 180, Fade(BLACK, 0.7f));
+        DrawText(TextFormat("threaded %s [T], tick %d", threaded ? "on" : "off", snap->tick), 10, 10, 20, WHITE);
+        DrawText(TextFormat("sim: %.2f ms / tick, load %s [U]", snap->tickMs, atomic_load(&updateLoad) ? "on" : "off"), 10, 35, 20, WHITE);
+        DrawText(TextFormat("draw: %.2f ms, load %s [R]", drawMs, drawLoad ? "on" : "off"), 10, 60, 20, WHITE);
+        DrawText(TextFormat("frame: %.2f ms", GetFrameTime() * 1000.0f), 10, 85, 20, WHITE);
+        DrawText(TextFormat("snapshot age: %.2f ms, skipped %d", snapshotAgeMs, skippedSnapshots), 10, 110, 20, WHITE);
+        DrawText(TextFormat("%d bullets, fired %d, escaped %d", snap->numBullets, snap->fired, snap->escaped), 10, 135, 20, WHITE);
+        DrawFPS(10, 160);
+
+        // Everything up to here, EndDrawing() is mostly waiting on vsync
+        drawMs = (wallTime() - start) * 1000.0;
+
+    EndDrawing();
+}
+
+/*
+Ticks at TICK_RATE until stopSim().
+If a tick runs long the next ones go straight after it to catch up, but never more than MAX_CATCHUP behind,
+past that we just give up on the missed time instead of spiralling.
+*/
+void *simThread(void *arg) {
+    (void) arg;
+
+    double tickTime = 1.0 / TICK_RATE;
+    double nextTick = wallTime();
+
+    while (atomic_load(&simRunning)) {
+        double now = wallTime();
+
+        if (now < nextTick) {
+            double wait = nextTick - now;
+            struct timespec sleepTime = {(time_t) wait, (long) ((wait - (time_t) wait) * 1000000000.0)};
+            nanosleep(&sleepTime, NULL);
+            continue;
+        }
+
+        if (now - nextTick > MAX_CATCHUP * tickTime) {
+            nextTick = now;
+        }
+        nextTick += tickTime;
+
+        simTick();
+        publishSnapshot((wallTime() - now) * 1000.0);
+    }
+
+    return NULL;
+}
+
+// Same as update() in borderOfWaveAndParticle.c minus the input, with NUM_TARGETS 24 instead of 5 and more bullets so there
+// is enough to draw to make the threading show
+void simTick(void) {
+    tick++;
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!bullets[i].isActive) {
+            continue;
+        }
+
+        bullets[i].position.x += bullets[i].velocity.x;
+        bullets[i].position.y += bullets[i].velocity.y;
+
+        if (bullets[i].position.x > SCREEN_WIDTH / 2 || bullets[i].position.x < -SCREEN_WIDTH / 2 ||
+            bullets[i].position.y > SCREEN_HEIGHT / 2 || bullets[i].position.y < -SCREEN_HEIGHT / 2) {
+            bullets[i].isActive = false;
+            escaped++;
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        // The targets are unit vectors, so the velocity is just a scaled copy
+        bullets[curBullet].isActive = true;
+        bullets[curBullet].position = targets[i];
+        bullets[curBullet].velocity = (Vector2) {targets[i].x * MAX_VELOCITY, targets[i].y * MAX_VELOCITY};
+        fired++;
+
+        curBullet++;
+        if (curBullet >= MAX_BULLETS) {
+            curBullet = 0;
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        // Rotated by the growing rotationAngle every tick like the original, so the spin speeds up over time
+        float xComponent = (targets[i].x * cos(rotationAngle * DEG2RAD)) - (targets[i].y * sin(rotationAngle * DEG2RAD));
+        float yComponent = (targets[i].x * sin(rotationAngle * DEG2RAD)) + (targets[i].y * cos(rotationAngle * DEG2RAD));
+
+        targets[i] = (Vector2) {xComponent, yComponent};
+    }
+    rotationAngle += deltaRAngle;
+
+    if (atomic_load(&updateLoad)) {
+        spinFor(UPDATE_LOAD_MS);
+    }
+}
+
+// Fills the back snapshot and swaps it into the middle, the main thread picks it up on its next frame
+void publishSnapshot(double tickMs) {
+    Snapshot *snap = &snapshots[back];
+
+    snap->tick = tick;
+    snap->tickMs = tickMs;
+    snap->fired = fired;
+    snap->escaped = escaped;
+
+    snap->numBullets = 0;
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isActive) {
+            snap->bullets[snap->numBullets++] = bullets[i].position;
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        snap->targets[i] = targets[i];
+    }
+
+    snap->publishTime = wallTime();
+
+    // The exchange is seq_cst, so everything written above is visible before the main thread can get this index
+    back = atomic_exchange(&middle, back | FRESH_BIT) & INDEX_MASK;
+}
+
+// If the thread can't be started we fall back to ticking on the main thread, same as pressing T
+void startSim(void) {
+    atomic_store(&simRunning, true);
+
+    if (pthread_create(&simThreadId, NULL, simThread, NULL) != 0) {
+        atomic_store(&simRunning, false);
+        threaded = false;
+        TraceLog(LOG_WARNING, "SIM: could not start the sim thread, ticking on the main thread");
+    }
+}
+
+void stopSim(void) {
+    if (!atomic_load(&simRunning)) {
+        return;
+    }
+
+    atomic_store(&simRunning, false);
+    pthread_join(simThreadId, NULL);
+}
+
+// Just your classic "n circular points made from rotating [1; 0] with a rotation matrix"
+void setTargets(void) {
+    float deltaAngle = 360.0f / NUM_TARGETS;
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float angle = (deltaAngle * i) * DEG2RAD;
+
+        targets[i].x = cos(angle);
+        targets[i].y = sin(angle);
+    }
+}
+
+// Stand-in for a heavy update or draw
+void spinFor(double ms) {
+    double end = wallTime() + ms / 1000.0;
+
+    while (wallTime() < end) {
+    }
+}
+
+double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + (now.tv_nsec / 1000000000.0);
+}
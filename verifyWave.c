@@ -0,0 +1,723 @@
+/*
+Verify Wave - October 2026
+
+Checks that a rewritten update() from "borderOfWaveAndParticle.c" still does exactly what the original does.
+Every way of running the simulation is a backend (init, update, and a way to read its bullets back in one common layout), and the whole state
+(every bullet, the targets, rotationAngle and curBullet) is hashed after every tick. Two backends agree if every hash agrees.
+As soon as one tick doesn't, we stop and print which fields of which bullets are different.
+
+Backends:
+    scalar      update() from borderOfWaveAndParticle.c as it is, the reference
+    soa         bullets split into one array per field, and the update loop has no branches so the compiler can vectorize it
+    fixed       positions and velocities in 16.16 fixed point. This one is expected to drift (that is what it is for, to show
+                what a divergence report looks like)
+Adding one is writing its 3 functions and adding it to backends[].
+
+Usage:
+    verifyWave lockstep [a] [b] [ticks]         run a and b side by side (default scalar soa VERIFY_TICKS)
+    verifyWave record [backend] [file] [ticks] [every]
+                                                save the hash of every tick, and the whole state every [every] ticks
+                                                (default scalar wave.hashes VERIFY_TICKS SNAPSHOT_TICKS)
+    verifyWave check [backend] [file]           run backend against a saved file (eg. one recorded by an older build)
+    verifyWave list                             list the backends
+
+check finds the divergent tick from the hashes, then keeps going to the next saved state and diffs against that, so the
+diff is of what the recording really had, even if the code that recorded it is gone (or is the same backend, changed since).
+With every = 1 that is the divergent tick itself, otherwise up to every - 1 ticks later (and the file is smaller).
+If the recorded backend is also in this build and isn't the one being checked, it gets run up to the divergent tick too,
+to say whether it is the checked backend or the recorded one that changed.
+Exits with 0 if everything matched, 1 at the first divergent tick, 2 if something else went wrong.
+
+The hash is 64 bits, a multiply and a shift per 32 bit word (lockstep prints what hashing costs next to the updates). Floats are hashed by their
+bits, so -0 and 0 or two different NaNs count as different. Inactive bullets only hash as "inactive", whatever is left in them
+doesn't matter.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "raylib.h"
+
+#define SCREEN_WIDTH 1600
+#define SCREEN_HEIGHT 900
+#define NUM_TARGETS 5
+#define MAX_BULLETS 1200
+#define MAX_VELOCITY 5
+
+#define VERIFY_TICKS 10000
+#define MAX_DIFF_LINES 20
+#define FIXED_ONE 65536
+
+#define HASH_MAGIC "WVHS"
+#define HASH_VERSION 2
+#define SNAPSHOT_TICKS 100
+
+// One bullet the same way for every backend, this is what gets hashed and diffed
+typedef struct BulletState {
+    bool isActive;
+    float x;
+    float y;
+    float vx;
+    float vy;
+} BulletState;
+
+// Targets, rotation and the next bullet to shoot, every backend has its own copy
+typedef struct Emitter {
+    Vector2 targets[NUM_TARGETS];
+    float rotationAngle;
+    int curBullet;
+} Emitter;
+
+typedef struct Backend {
+    const char *name;
+    void (*init)(void);
+    void (*update)(void);
+    void (*getState)(BulletState *out);
+    Emitter *emitter;
+} Backend;
+
+typedef struct HashHeader {
+    char magic[4];
+    uint32_t version;
+    char backend[16];
+    uint32_t numTicks;
+    uint32_t snapshotEvery;
+    uint32_t emitterSize;
+    uint32_t bulletSize;
+} HashHeader;
+
+/*
+After the header, every tick is its 64 bit hash, and every snapshotEvery ticks that is followed by the whole state:
+    Emitter, then BulletState[MAX_BULLETS]
+written as the structs are, emitterSize and bulletSize are there to catch a build where they aren't laid out the same
+*/
+
+void emitterInit(Emitter *e);
+void emitterRotate(Emitter *e);
+Vector2 shotVelocity(Vector2 target);
+
+void scalarInit(void);
+void scalarUpdate(void);
+void scalarGet(BulletState *out);
+void soaInit(void);
+void soaUpdate(void);
+void soaGet(BulletState *out);
+void fixedInit(void);
+void fixedUpdate(void);
+void fixedGet(BulletState *out);
+
+const Backend *findBackend(const char *name);
+uint64_t hashState(const Backend *b);
+int diffStates(const Emitter *ea, const BulletState *sa, const Emitter *eb, const BulletState *sb);
+int lockstep(const Backend *a, const Backend *b, int ticks);
+int record(const Backend *b, const char *path, int ticks, int every);
+int check(const Backend *b, const char *path);
+double wallTime(void);
+
+const float deltaRAngle = 0.225f;
+
+// Bullets read back from a backend for hashing or diffing
+BulletState stateA[MAX_BULLETS];
+BulletState stateB[MAX_BULLETS];
+
+// A state read back from a hash file
+Emitter recordedEmitter;
+BulletState recordedState[MAX_BULLETS];
+
+// scalar ================================================================
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    bool isActive;
+} Bullet;
+
+Bullet scalarBullets[MAX_BULLETS];
+Emitter scalarEmitter;
+
+// soa ===================================================================
+
+float soaX[MAX_BULLETS];
+float soaY[MAX_BULLETS];
+float soaVX[MAX_BULLETS];
+float soaVY[MAX_BULLETS];
+float soaActive[MAX_BULLETS];
+Emitter soaEmitter;
+
+// fixed =================================================================
+
+int32_t fixedX[MAX_BULLETS];
+int32_t fixedY[MAX_BULLETS];
+int32_t fixedVX[MAX_BULLETS];
+int32_t fixedVY[MAX_BULLETS];
+bool fixedActive[MAX_BULLETS];
+Emitter fixedEmitter;
+
+const Backend backends[] = {
+    {"scalar", scalarInit, scalarUpdate, scalarGet, &scalarEmitter},
+    {"soa", soaInit, soaUpdate, soaGet, &soaEmitter},
+    {"fixed", fixedInit, fixedUpdate, fixedGet, &fixedEmitter},
+};
+#define NUM_BACKENDS ((int) (sizeof(backends) / sizeof(backends[0])))
+
+int main(int argc, char **argv) {
+
+    const char *mode = (argc >= 2) ? argv[1] : "lockstep";
+
+    if (strcmp(mode, "list") == 0) {
+        for (int i = 0; i < NUM_BACKENDS; i++) {
+            printf("%s\n", backends[i].name);
+        }
+        return 0;
+    }
+
+    const Backend *a = findBackend((argc >= 3) ? argv[2] : "scalar");
+    if (a == NULL) {
+        return 2;
+    }
+
+    if (strcmp(mode, "lockstep") == 0) {
+        const Backend *b = findBackend((argc >= 4) ? argv[3] : "soa");
+        if (b == NULL) {
+            return 2;
+        }
+
+        return lockstep(a, b, (argc >= 5) ? atoi(argv[4]) : VERIFY_TICKS);
+    }
+    else if (strcmp(mode, "record") == 0) {
+        return record(a, (argc >= 4) ? argv[3] : "wave.hashes", (argc >= 5) ? atoi(argv[4]) : VERIFY_TICKS,
+                      (argc >= 6) ? atoi(argv[5]) : SNAPSHOT_TICKS);
+    }
+    else if (strcmp(mode, "check") == 0) {
+        return check(a, (argc >= 4) ? argv[3] : "wave.hashes");
+    }
+
+    fprintf(stderr, "usage: verifyWave lockstep|record|check|list ...\n");
+    return 2;
+}
+
+// Shared emitter code, exactly the maths from borderOfWaveAndParticle.c ==
+
+void emitterInit(Emitter *e) {
+    float deltaAngle = 360 / NUM_TARGETS;
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float angle = (deltaAngle * i) * DEG2RAD;
+
+        e->targets[i].x = cos(angle);
+        e->targets[i].y = sin(angle);
+    }
+
+    e->rotationAngle = 0;
+    e->curBullet = 0;
+}
+
+void emitterRotate(Emitter *e) {
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        float xComponent = (e->targets[i].x * cos(e->rotationAngle * DEG2RAD)) -
+                           (e->targets[i].y * sin(e->rotationAngle * DEG2RAD));
+        float yComponent = (e->targets[i].x * sin(e->rotationAngle * DEG2RAD)) +
+                           (e->targets[i].y * cos(e->rotationAngle * DEG2RAD));
+        e->targets[i] = (Vector2) {xComponent, yComponent};
+    }
+
+    e->rotationAngle += deltaRAngle;
+}
+
+// getVelocities() from borderOfWaveAndParticle.c
+Vector2 shotVelocity(Vector2 target) {
+    float hyp = sqrt(pow(target.x, 2) + pow(target.y, 2));
+
+    return (Vector2) {MAX_VELOCITY * (target.x / hyp), MAX_VELOCITY * (target.y / hyp)};
+}
+
+// scalar ================================================================
+
+void scalarInit(void) {
+    emitterInit(&scalarEmitter);
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        scalarBullets[i].position = (Vector2) {0, 0};
+        scalarBullets[i].velocity = (Vector2) {0, 0};
+        scalarBullets[i].isActive = false;
+    }
+}
+
+void scalarUpdate(void) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (scalarBullets[i].isActive) {
+            scalarBullets[i].position.x += scalarBullets[i].velocity.x;
+            scalarBullets[i].position.y += scalarBullets[i].velocity.y;
+        }
+
+        if (scalarBullets[i].position.x > SCREEN_WIDTH / 2 || scalarBullets[i].position.x < -SCREEN_WIDTH / 2 ||
+            scalarBullets[i].position.y > SCREEN_HEIGHT / 2 || scalarBullets[i].position.y < -SCREEN_HEIGHT / 2) {
+            scalarBullets[i].position = (Vector2) {0, 0};
+            scalarBullets[i].velocity = (Vector2) {0, 0};
+            scalarBullets[i].isActive = false;
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        int b = scalarEmitter.curBullet;
+
+        scalarBullets[b].isActive = true;
+        scalarBullets[b].velocity = shotVelocity(scalarEmitter.targets[i]);
+        scalarBullets[b].position = scalarEmitter.targets[i];
+
+        scalarEmitter.curBullet = (b + 1 >= MAX_BULLETS) ? 0 : b + 1;
+    }
+
+    emitterRotate(&scalarEmitter);
+}
+
+void scalarGet(BulletState *out) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        out[i].isActive = scalarBullets[i].isActive;
+        out[i].x = scalarBullets[i].position.x;
+        out[i].y = scalarBullets[i].position.y;
+        out[i].vx = scalarBullets[i].velocity.x;
+        out[i].vy = scalarBullets[i].velocity.y;
+    }
+}
+
+// soa ===================================================================
+
+void soaInit(void) {
+    emitterInit(&soaEmitter);
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        soaX[i] = 0;
+        soaY[i] = 0;
+        soaVX[i] = 0;
+        soaVY[i] = 0;
+        soaActive[i] = 0;
+    }
+}
+
+/*
+Same as scalarUpdate, without the branches:
+    an inactive bullet has velocity 0 and position 0, so adding velocity * active (1 or 0) gives the same floats as only adding when active
+    an out of bounds bullet has every field picked as 0 instead, which compiles to a blend
+*/
+void soaUpdate(void) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        float x = soaX[i] + soaVX[i] * soaActive[i];
+        float y = soaY[i] + soaVY[i] * soaActive[i];
+        bool out = (x > SCREEN_WIDTH / 2) | (x < -SCREEN_WIDTH / 2) | (y > SCREEN_HEIGHT / 2) | (y < -SCREEN_HEIGHT / 2);
+
+        soaX[i] = out ? 0.0f : x;
+        soaY[i] = out ? 0.0f : y;
+        soaVX[i] = out ? 0.0f : soaVX[i];
+        soaVY[i] = out ? 0.0f : soaVY[i];
+        soaActive[i] = out ? 0.0f : soaActive[i];
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        int b = soaEmitter.curBullet;
+        Vector2 velocity = shotVelocity(soaEmitter.targets[i]);
+
+        soaActive[b] = 1;
+        soaVX[b] = velocity.x;
+        soaVY[b] = velocity.y;
+        soaX[b] = soaEmitter.targets[i].x;
+        soaY[b] = soaEmitter.targets[i].y;
+
+        soaEmitter.curBullet = (b + 1 >= MAX_BULLETS) ? 0 : b + 1;
+    }
+
+    emitterRotate(&soaEmitter);
+}
+
+void soaGet(BulletState *out) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        out[i].isActive = soaActive[i] != 0;
+        out[i].x = soaX[i];
+        out[i].y = soaY[i];
+        out[i].vx = soaVX[i];
+        out[i].vy = soaVY[i];
+    }
+}
+
+// fixed =================================================================
+
+void fixedInit(void) {
+    emitterInit(&fixedEmitter);
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        fixedX[i] = 0;
+        fixedY[i] = 0;
+        fixedVX[i] = 0;
+        fixedVY[i] = 0;
+        fixedActive[i] = false;
+    }
+}
+
+void fixedUpdate(void) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (fixedActive[i]) {
+            fixedX[i] += fixedVX[i];
+            fixedY[i] += fixedVY[i];
+        }
+
+        if (fixedX[i] > (SCREEN_WIDTH / 2) * FIXED_ONE || fixedX[i] < -(SCREEN_WIDTH / 2) * FIXED_ONE ||
+            fixedY[i] > (SCREEN_HEIGHT / 2) * FIXED_ONE || fixedY[i] < -(SCREEN_HEIGHT / 2) * FIXED_ONE) {
+            fixedX[i] = 0;
+            fixedY[i] = 0;
+            fixedVX[i] = 0;
+            fixedVY[i] = 0;
+            fixedActive[i] = false;
+        }
+    }
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        int b = fixedEmitter.curBullet;
+        Vector2 velocity = shotVelocity(fixedEmitter.targets[i]);
+
+        fixedActive[b] = true;
+        fixedVX[b] = lroundf(velocity.x * FIXED_ONE);
+        fixedVY[b] = lroundf(velocity.y * FIXED_ONE);
+        fixedX[b] = lroundf(fixedEmitter.targets[i].x * FIXED_ONE);
+        fixedY[b] = lroundf(fixedEmitter.targets[i].y * FIXED_ONE);
+
+        fixedEmitter.curBullet = (b + 1 >= MAX_BULLETS) ? 0 : b + 1;
+    }
+
+    emitterRotate(&fixedEmitter);
+}
+
+void fixedGet(BulletState *out) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        out[i].isActive = fixedActive[i];
+        out[i].x = (float) fixedX[i] / FIXED_ONE;
+        out[i].y = (float) fixedY[i] / FIXED_ONE;
+        out[i].vx = (float) fixedVX[i] / FIXED_ONE;
+        out[i].vy = (float) fixedVY[i] / FIXED_ONE;
+    }
+}
+
+// Hashing and diffing ===================================================
+
+const Backend *findBackend(const char *name) {
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        if (strcmp(backends[i].name, name) == 0) {
+            return &backends[i];
+        }
+    }
+
+    fprintf(stderr, "no backend called %s (try \"verifyWave list\")\n", name);
+    return NULL;
+}
+
+static inline uint64_t hashWord(uint64_t h, uint32_t word) {
+    h ^= word;
+    h *= 0x9E3779B97F4A7C15ull;
+    h ^= h >> 29;
+
+    return h;
+}
+
+static inline uint64_t hashFloat(uint64_t h, float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+
+    return hashWord(h, bits);
+}
+
+/*
+Four lanes (x, y, vx, vy) that only get mixed together at the end, so the multiplies of one bullet don't have to wait for each other.
+An inactive bullet hashes as 0xFFFFFFFF in the x lane and 0 in the rest (0xFFFFFFFF is a NaN no live bullet should have).
+*/
+uint64_t hashState(const Backend *b) {
+    uint64_t h[4] = {0xCBF29CE484222325ull, 1, 2, 3};
+    const Emitter *e = b->emitter;
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        h[0] = hashFloat(h[0], e->targets[i].x);
+        h[1] = hashFloat(h[1], e->targets[i].y);
+    }
+
+    h[2] = hashFloat(h[2], e->rotationAngle);
+    h[3] = hashWord(h[3], e->curBullet);
+
+    b->getState(stateA);
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        const BulletState s = stateA[i];
+
+        if (!s.isActive) {
+            h[0] = hashWord(h[0], 0xFFFFFFFF);
+            h[1] = hashWord(h[1], 0);
+            h[2] = hashWord(h[2], 0);
+            h[3] = hashWord(h[3], 0);
+            continue;
+        }
+
+        h[0] = hashFloat(h[0], s.x);
+        h[1] = hashFloat(h[1], s.y);
+        h[2] = hashFloat(h[2], s.vx);
+        h[3] = hashFloat(h[3], s.vy);
+    }
+
+    uint64_t result = h[0];
+    for (int lane = 1; lane < 4; lane++) {
+        result = hashWord(result, (uint32_t) h[lane]);
+        result = hashWord(result, (uint32_t) (h[lane] >> 32));
+    }
+
+    return result;
+}
+
+// Prints every field that differs (bullets up to MAX_DIFF_LINES of them), returns how many bullets differ
+int diffStates(const Emitter *ea, const BulletState *sa, const Emitter *eb, const BulletState *sb) {
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        if (memcmp(&ea->targets[i], &eb->targets[i], sizeof(Vector2)) != 0) {
+            printf("  target %d: (%.9g, %.9g) vs (%.9g, %.9g)\n", i,
+                   ea->targets[i].x, ea->targets[i].y, eb->targets[i].x, eb->targets[i].y);
+        }
+    }
+
+    if (memcmp(&ea->rotationAngle, &eb->rotationAngle, sizeof(float)) != 0) {
+        printf("  rotationAngle: %.9g vs %.9g\n", ea->rotationAngle, eb->rotationAngle);
+    }
+
+    if (ea->curBullet != eb->curBullet) {
+        printf("  curBullet: %d vs %d\n", ea->curBullet, eb->curBullet);
+    }
+
+    int differ = 0;
+
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        const BulletState a = sa[i];
+        const BulletState b = sb[i];
+
+        // Compared the same way they are hashed
+        bool active = a.isActive != b.isActive;
+        bool x = a.isActive && b.isActive && memcmp(&a.x, &b.x, sizeof(float)) != 0;
+        bool y = a.isActive && b.isActive && memcmp(&a.y, &b.y, sizeof(float)) != 0;
+        bool vx = a.isActive && b.isActive && memcmp(&a.vx, &b.vx, sizeof(float)) != 0;
+        bool vy = a.isActive && b.isActive && memcmp(&a.vy, &b.vy, sizeof(float)) != 0;
+
+        if (!(active || x || y || vx || vy)) {
+            continue;
+        }
+
+        differ++;
+
+        if (differ > MAX_DIFF_LINES) {
+            continue;
+        }
+
+        printf("  bullet %4d:", i);
+        if (active) { printf(" isActive %d vs %d", a.isActive, b.isActive); }
+        if (x) { printf(" x %.9g vs %.9g", a.x, b.x); }
+        if (y) { printf(" y %.9g vs %.9g", a.y, b.y); }
+        if (vx) { printf(" vx %.9g vs %.9g", a.vx, b.vx); }
+        if (vy) { printf(" vy %.9g vs %.9g", a.vy, b.vy); }
+        printf("\n");
+    }
+
+    if (differ > MAX_DIFF_LINES) {
+        printf("  ... and %d more bullets\n", differ - MAX_DIFF_LINES);
+    }
+
+    return differ;
+}
+
+// Modes =================================================================
+
+int lockstep(const Backend *a, const Backend *b, int ticks) {
+    double timeA = 0, timeB = 0, timeHash = 0;
+
+    a->init();
+    b->init();
+
+    for (int tick = 1; tick <= ticks; tick++) {
+        double start = wallTime();
+        a->update();
+        double mid = wallTime();
+        b->update();
+        double end = wallTime();
+
+        uint64_t ha = hashState(a);
+        uint64_t hb = hashState(b);
+
+        timeA += mid - start;
+        timeB += end - mid;
+        timeHash += wallTime() - end;
+
+        if (ha != hb) {
+            printf("%s and %s diverge at tick %d (%016llx vs %016llx)\n", a->name, b->name, tick,
+                   (unsigned long long) ha, (unsigned long long) hb);
+            a->getState(stateA);
+            b->getState(stateB);
+            printf("%d bullets differ\n", diffStates(a->emitter, stateA, b->emitter, stateB));
+            return 1;
+        }
+    }
+
+    printf("%s and %s match for %d ticks\n", a->name, b->name, ticks);
+    printf("update: %s %.2f us, %s %.2f us, hashing both %.2f us a tick\n",
+           a->name, timeA * 1e6 / ticks, b->name, timeB * 1e6 / ticks, timeHash * 1e6 / ticks);
+
+    return 0;
+}
+
+int record(const Backend *b, const char *path, int ticks, int every) {
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) {
+        fprintf(stderr, "could not write %s\n", path);
+        return 2;
+    }
+
+    HashHeader header = { 0 };
+    memcpy(header.magic, HASH_MAGIC, 4);
+    header.version = HASH_VERSION;
+    strncpy(header.backend, b->name, sizeof(header.backend) - 1);
+    header.numTicks = ticks;
+    header.snapshotEvery = (every > 0) ? every : 0;
+    header.emitterSize = sizeof(Emitter);
+    header.bulletSize = sizeof(BulletState);
+
+    fwrite(&header, sizeof(header), 1, file);
+
+    b->init();
+
+    for (int tick = 1; tick <= ticks; tick++) {
+        b->update();
+
+        uint64_t h = hashState(b);
+        fwrite(&h, sizeof(h), 1, file);
+
+        if (header.snapshotEvery > 0 && tick % header.snapshotEvery == 0) {
+            b->getState(stateA);
+            fwrite(b->emitter, sizeof(Emitter), 1, file);
+            fwrite(stateA, sizeof(BulletState), MAX_BULLETS, file);
+        }
+    }
+
+    fclose(file);
+    printf("wrote %s: %d ticks of %s, the whole state every %u ticks\n", path, ticks, b->name, header.snapshotEvery);
+
+    return 0;
+}
+
+int check(const Backend *b, const char *path) {
+    FILE *file = fopen(path, "rb");
+    HashHeader header;
+
+    if (file == NULL) {
+        fprintf(stderr, "could not open %s, run \"verifyWave record\" first\n", path);
+        return 2;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, HASH_MAGIC, 4) != 0 || header.version != HASH_VERSION ||
+        header.emitterSize != sizeof(Emitter) || header.bulletSize != sizeof(BulletState)) {
+        fprintf(stderr, "%s is not a hash file from this version\n", path);
+        fclose(file);
+        return 2;
+    }
+
+    header.backend[sizeof(header.backend) - 1] = '\0';
+
+    b->init();
+
+    int bad = 0;
+    int diffedAt = 0;
+
+    for (int tick = 1; tick <= (int) header.numTicks; tick++) {
+        uint64_t expected;
+
+        if (fread(&expected, sizeof(expected), 1, file) != 1) {
+            fprintf(stderr, "%s ends early at tick %d\n", path, tick);
+            fclose(file);
+            return 2;
+        }
+
+        b->update();
+
+        if (bad == 0 && hashState(b) != expected) {
+            bad = tick;
+            printf("%s diverges from %s (%s) at tick %d\n", b->name, path, header.backend, bad);
+        }
+
+        if (header.snapshotEvery == 0 || tick % header.snapshotEvery != 0) {
+            continue;
+        }
+
+        if (fread(&recordedEmitter, sizeof(Emitter), 1, file) != 1 ||
+            fread(recordedState, sizeof(BulletState), MAX_BULLETS, file) != MAX_BULLETS) {
+            fprintf(stderr, "%s ends early at tick %d\n", path, tick);
+            fclose(file);
+            return 2;
+        }
+
+        // The first saved state at or after the bad tick is what we diff against
+        if (bad != 0) {
+            b->getState(stateB);
+
+            printf("recorded %s vs %s at tick %d:\n", header.backend, b->name, tick);
+            printf("%d bullets differ\n", diffStates(&recordedEmitter, recordedState, b->emitter, stateB));
+
+            diffedAt = tick;
+            break;
+        }
+    }
+
+    fclose(file);
+
+    if (bad == 0) {
+        printf("%s matches %s (%s) for %u ticks\n", b->name, path, header.backend, header.numTicks);
+        return 0;
+    }
+
+    if (diffedAt == 0) {
+        printf("  (no state saved at or after tick %d to diff against, record with a smaller [every])\n", bad);
+    }
+
+    // Which side changed, if both are here to ask
+    const Backend *reference = findBackend(header.backend);
+
+    if (reference == NULL) {
+        printf("  there is no %s backend in this build, so only the recording can say what it had\n", header.backend);
+        return 1;
+    }
+
+    if (reference == b) {
+        printf("  it was recorded with %s, so %s has changed since the recording\n", b->name, b->name);
+        return 1;
+    }
+
+    reference->init();
+    b->init();
+    for (int tick = 1; tick <= bad; tick++) {
+        reference->update();
+        b->update();
+    }
+
+    if (hashState(reference) != hashState(b)) {
+        reference->getState(stateA);
+        b->getState(stateB);
+        printf("%s in this build vs %s at tick %d:\n", reference->name, b->name, bad);
+        printf("%d bullets differ\n", diffStates(reference->emitter, stateA, b->emitter, stateB));
+    }
+    else {
+        printf("  %s in this build matches %s here, so it is %s itself that changed since the recording\n",
+               reference->name, b->name, reference->name);
+    }
+
+    return 1;
+}
+
+// GetTime() needs a window, and there isn't one here
+double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + (now.tv_nsec / 1000000000.0);
+}